@@ -0,0 +1,96 @@
+// === Invitono Microbenchmarks === //
+// --- Times the hot actions natively and counts their table work --- //
+
+#include <random>
+#include "fixture.hpp"
+
+using namespace bench;
+
+namespace {
+
+  // - Grows a random tree: each new user is invited by a uniformly chosen member
+  series time_redeeminvite(uint32_t users, std::mt19937_64& rng, std::vector<name>& members) {
+    series result{"redeeminvite"};
+    for (uint32_t i = 0; i < users; i++) {
+      name user = new_account(i);
+      name inviter = members.empty() ? SELF : members[rng() % members.size()];
+
+      // - One refill interval per invite keeps every member's bucket full
+      advance(60);
+      sample s = measure({user}, [&](invitono& c) { c.redeeminvite(user, inviter); });
+      if (!s.ok) {
+        std::fprintf(stderr, "redeeminvite %s <- %s failed: %s\n", user.to_string().c_str(), inviter.to_string().c_str(), host::chain().error.c_str());
+        std::exit(2);
+      }
+      result.add(s);
+      members.push_back(user);
+    }
+    return result;
+  }
+
+  // - Credits one more invite to each sampled member's path, as redeeminvite does for a new user below them
+  series time_update_scores(const std::vector<name>& members, uint32_t count, std::mt19937_64& rng) {
+    series result{"update_scores"};
+    for (uint32_t i = 0; i < count; i++) {
+      name member = members[rng() % members.size()];
+      result.add(measure({SELF}, [&](invitono& c) {
+        const auto* row = access::find_adopter(c, member);
+        std::vector<name> upline{member};
+        upline.insert(upline.end(), row->upline.begin(), row->upline.end());
+        access::update_scores(c, upline, access::current_config(c).max_referral_depth, 1, host::now());
+      }));
+    }
+    return result;
+  }
+
+  // - Claims for every member with a score, queueing one payout each
+  series time_claimreward(const std::vector<name>& members) {
+    series result{"claimreward"};
+    for (name member : members) {
+      bool scored = false;
+      act({}, [&](invitono& c) { scored = access::find_adopter(c, member)->score.value > 0; });
+      if (!scored) continue;
+
+      sample s = measure({member}, [&](invitono& c) { c.claimreward(member); });
+      if (s.ok) result.add(s);
+    }
+    return result;
+  }
+
+  // - Pure arithmetic: no table access, so timed in one tight loop
+  series time_curve_position(uint32_t count) {
+    invitono::contract_config cfg;
+    volatile uint32_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t score = 0; score < count; score++) sink = sink + access::calculate_curve_position(score, cfg);
+    auto stop = std::chrono::steady_clock::now();
+
+    sample s;
+    s.ns = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count() / count;
+    return series{"calculate_curve_position", std::vector<sample>(1, s)};
+  }
+
+  uint32_t flag_value(int argc, char** argv, const char* flag, uint32_t fallback) {
+    for (int i = 1; i + 1 < argc; i++) {
+      if (std::string(argv[i]) == flag) return static_cast<uint32_t>(std::stoul(argv[i + 1]));
+    }
+    return fallback;
+  }
+
+} // namespace
+
+int main(int argc, char** argv) {
+  uint32_t users = flag_value(argc, argv, "--users", 2000);
+  std::mt19937_64 rng(flag_value(argc, argv, "--seed", 1));
+
+  boot(setup{});
+  std::vector<name> members;
+
+  print_header();
+  print_series(time_redeeminvite(users, rng, members));
+  print_series(time_update_scores(members, users, rng));
+  print_series(time_claimreward(members));
+  print_series(time_curve_position(1000000));
+  return 0;
+}
@@ -0,0 +1,156 @@
+#!/bin/sh
+# Replays the bench workloads (deep chain, wide fan, claim storm with its processq crank) on a local
+# single-node chain and records billed CPU, NET and RAM per action in a CSV. With chain_budgets.txt
+# present, fails when a workload's worst action exceeds its budget there (lines: workload action
+# metric max, where metric is cpu_us, net_bytes or ram_bytes). `chain.sh --record` writes the worst
+# values with 10% headroom to chain_budgets.txt instead, like `make budgets`.
+#
+# Needs: a running nodeos whose creator account can run `cleos create account`, the development key
+# below imported into an unlocked wallet, jq, contract/invitono.wasm built with eosio-cpp, and a built
+# eosio.token in TOKEN_DIR, which is deployed to pay the claims.
+
+set -eu
+
+CLEOS=${CLEOS:-cleos}
+CREATOR=${CREATOR:-eosio}
+CONTRACT=${CONTRACT:-invitono}
+TOKEN=${TOKEN:-eosio.token}
+TOKEN_DIR=${TOKEN_DIR:?set TOKEN_DIR to the directory holding eosio.token.wasm and eosio.token.abi}
+KEY=${KEY:-EOS6MRyAjQq8ud7hVNYcfnVPJqcVpscN5So8BhtHuGYqET5GDW5CV}
+USERS=${USERS:-50}
+OUT=${OUT:-chain_profile.csv}
+BUDGETS=${BUDGETS:-chain_budgets.txt}
+DIR=$(cd "$(dirname "$0")" && pwd)
+RECORD=false
+[ "${1:-}" = "--record" ] && RECORD=true
+
+# - Account name: prefix then n in four letters
+acct() {
+  n=$2
+  s=""
+  for _ in 1 2 3 4; do
+    s="$s$(printf '%s' abcdefghijklmnopqrstuvwxyz | cut -c $((n % 26 + 1)))"
+    n=$((n / 26))
+  done
+  echo "$1$s"
+}
+
+ram() {
+  $CLEOS get account "$1" -j | jq '.ram_usage'
+}
+
+# - Pushes one action and appends workload,action,actor,cpu_us,net_bytes,ram_bytes; RAM counts the contract and the actor
+push() {
+  workload=$1 action=$2 data=$3 actor=$4
+  before=$(( $(ram "$CONTRACT") + $(ram "$actor") ))
+  trace=$($CLEOS push action "$CONTRACT" "$action" "$data" -p "$actor" -j -f) || return 1
+  after=$(( $(ram "$CONTRACT") + $(ram "$actor") ))
+  cpu=$(echo "$trace" | jq '.processed.receipt.cpu_usage_us')
+  net=$(echo "$trace" | jq '.processed.receipt.net_usage_words * 8')
+  echo "$workload,$action,$actor,$cpu,$net,$((after - before))" >> "$OUT"
+}
+
+# - awk helper keeping the highest value seen per key; freed RAM makes some values negative
+HIGH='function high(key, v) { if (!(key in worst) || v > worst[key]) worst[key] = v }'
+
+# === Deploy === #
+$CLEOS create account "$CREATOR" "$CONTRACT" "$KEY" "$KEY" > /dev/null
+$CLEOS create account "$CREATOR" "$TOKEN" "$KEY" "$KEY" > /dev/null 2>&1 || true
+$CLEOS set contract "$CONTRACT" "$DIR/../contract" invitono.wasm invitono.abi > /dev/null
+
+# - processq sends inline transfers, so the contract holds TONO and its active permission includes eosio.code
+$CLEOS set contract "$TOKEN" "$TOKEN_DIR" eosio.token.wasm eosio.token.abi > /dev/null
+$CLEOS push action "$TOKEN" create "[\"$TOKEN\", \"1000000000.000000 TONO\"]" -p "$TOKEN" > /dev/null
+$CLEOS push action "$TOKEN" issue "[\"$TOKEN\", \"1000000000.000000 TONO\", \"bench\"]" -p "$TOKEN" > /dev/null
+$CLEOS push action "$TOKEN" transfer "[\"$TOKEN\", \"$CONTRACT\", \"1000000000.000000 TONO\", \"bench\"]" -p "$TOKEN" > /dev/null
+$CLEOS set account permission "$CONTRACT" active --add-code > /dev/null
+
+# - No age requirement, deepest referral depth, one invite token per second up to 1000
+$CLEOS push action "$CONTRACT" setconfig "[\"$CONTRACT\", 0, 1, true, 64, 100, \"$TOKEN\", \"6,TONO\", 100]" -p "$CONTRACT" > /dev/null
+$CLEOS push action "$CONTRACT" setlimiter '[1000, 1]' -p "$CONTRACT" > /dev/null
+
+echo "workload,action,actor,cpu_us,net_bytes,ram_bytes" > "$OUT"
+
+# === Deep Chain === #
+inviter=$CONTRACT
+i=0
+while [ $i -lt "$USERS" ]; do
+  user=$(acct dc $i)
+  $CLEOS create account "$CREATOR" "$user" "$KEY" "$KEY" > /dev/null
+  sleep 2
+  push deep-chain redeeminvite "[\"$user\", \"$inviter\"]" "$user"
+  inviter=$user
+  i=$((i + 1))
+done
+
+# === Wide Fan === #
+root=$(acct wf 0)
+$CLEOS create account "$CREATOR" "$root" "$KEY" "$KEY" > /dev/null
+$CLEOS push action "$CONTRACT" redeeminvite "[\"$root\", \"$CONTRACT\"]" -p "$root" > /dev/null
+i=1
+while [ $i -le "$USERS" ]; do
+  user=$(acct wf $i)
+  $CLEOS create account "$CREATOR" "$user" "$KEY" "$KEY" > /dev/null
+  sleep 2
+  push wide-fan redeeminvite "[\"$user\", \"$root\"]" "$user"
+  i=$((i + 1))
+done
+
+# === Claim Storm === #
+i=0
+while [ $i -lt "$USERS" ]; do
+  user=$(acct dc $i)
+  push claim-storm claimreward "[\"$user\"]" "$user"
+  i=$((i + 1))
+done
+
+# - The crank drains the queued payouts in chunks; anyone may push it, and the creator's RAM doesn't move
+while [ "$($CLEOS get table "$CONTRACT" "$CONTRACT" payouts -l 1 -j | jq '.rows | length')" -gt 0 ]; do
+  push claim-storm processq '[50]' "$CREATOR"
+done
+
+# === Summary === #
+echo "workload       action         count  cpu_us max  net_bytes max  ram_bytes max"
+awk -F, "$HIGH"' NR > 1 {
+  key = $1 " " $2; n[key]++
+  high(key " cpu_us", $4); high(key " net_bytes", $5); high(key " ram_bytes", $6)
+} END {
+  for (key in n) { split(key, k, " "); printf "%-14s %-14s %5d %11d %14d %14d\n", k[1], k[2], n[key], worst[key " cpu_us"], worst[key " net_bytes"], worst[key " ram_bytes"] }
+}' "$OUT"
+
+# - Worst action per workload with 10% headroom; the first run on a reference node records the baseline
+if $RECORD; then
+  {
+    echo "# workload     action         metric     max"
+    echo "# Recorded by \`chain.sh --record\` with 10% headroom; CPU varies by node, so record on the reference node."
+    awk -F, "$HIGH"' NR > 1 {
+      key = $1 " " $2
+      high(key " cpu_us", $4); high(key " net_bytes", $5); high(key " ram_bytes", $6)
+    } END {
+      for (key in worst) { split(key, k, " "); v = worst[key]; printf "%-14s %-14s %-10s %d\n", k[1], k[2], k[3], v + (v < 0 ? -v : v) * 0.1 }
+    }' "$OUT" | sort
+  } > "$BUDGETS"
+  echo "budgets written to $BUDGETS"
+  exit 0
+fi
+
+[ -f "$BUDGETS" ] || exit 0
+
+awk -F, "$HIGH"' FNR == NR {
+  sub(/#.*/, "")
+  if (NF == 0) next
+  split($0, b, " ")
+  if (b[4] != "") budget[b[1] " " b[2] " " b[3]] = b[4]
+  next
+} FNR > 1 {
+  key = $1 " " $2
+  high(key " cpu_us", $4); high(key " net_bytes", $5); high(key " ram_bytes", $6)
+} END {
+  over = 0
+  for (key in budget) {
+    status = worst[key] > budget[key] ? "OVER" : "ok"
+    if (status == "OVER") over++
+    printf "%-40s %10d / %10d %s\n", key, worst[key], budget[key], status
+  }
+  exit over > 0
+}' "$BUDGETS" "$OUT"
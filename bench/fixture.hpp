@@ -0,0 +1,210 @@
+#pragma once
+
+// === Bench Fixture === //
+// --- The contract built natively over the in-memory host, with helpers to run and measure actions --- //
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <eosio/eosio.hpp>
+#include <eosio/singleton.hpp>
+
+#include "invitono.cpp"
+
+/*/
+Internal helpers the harness times or inspects, reached through the contract's friend declaration
+/*/
+class invitono_bench {
+public:
+  static constexpr uint16_t MAX_REFERRAL_DEPTH = invitono::MAX_REFERRAL_DEPTH;
+  static constexpr uint32_t MAX_PAYOUT_ITEMS = invitono::MAX_PAYOUT_ITEMS;
+
+  static const invitono::adopterv2* find_adopter(invitono& contract, eosio::name account) {
+    return contract.find_adopter(account);
+  }
+
+  static const invitono::contract_config& current_config(invitono& contract) {
+    return contract.current_config();
+  }
+
+  static void update_scores(invitono& contract, const std::vector<eosio::name>& upline, uint16_t depth, uint32_t increment, uint32_t now) {
+    contract.update_scores(upline, depth, increment, now);
+  }
+
+  static uint32_t calculate_curve_position(uint32_t score, const invitono::contract_config& cfg) {
+    return invitono::calculate_curve_position(score, cfg);
+  }
+};
+
+namespace bench {
+
+  using access = invitono_bench;
+
+  using eosio::name;
+  using eosio::permission_level;
+
+  inline const name SELF = "invitono"_n;
+  inline const name ADMIN = "admin"_n;
+  inline const name TOKEN = "eosio.token"_n;
+
+  // - Day zero of every run; accounts are created well before it so the age check passes
+  static constexpr uint32_t GENESIS = 1700000000;
+
+  // - Distinct 12-character account names: "u" then the index in base 31 (no dots)
+  inline name user_name(uint64_t index) {
+    static const char* digits = "abcdefghijklmnopqrstuvwxyz12345";
+    std::string str = "u";
+    for (int i = 0; i < 11; i++) {
+      str += digits[index % 31];
+      index /= 31;
+    }
+    return name(std::string_view(str));
+  }
+
+  // - Runs one action as signers against a fresh contract object; false when a check fails (error in host::chain().error)
+  template <typename F>
+  bool act(std::vector<name> signers, F&& body) {
+    std::vector<permission_level> auths;
+    for (const auto& signer : signers) auths.emplace_back(signer, "active"_n);
+    return host::transact(std::move(auths), [&]() {
+      invitono contract(SELF, SELF, eosio::datastream<const char*>(nullptr, 0));
+      body(contract);
+    });
+  }
+
+  // - Like act, but stops the run on a failed check
+  template <typename F>
+  void must(std::vector<name> signers, F&& body) {
+    if (!act(std::move(signers), std::forward<F>(body))) {
+      std::fprintf(stderr, "action failed: %s\n", host::chain().error.c_str());
+      std::exit(2);
+    }
+  }
+
+  /*/
+  Cost of one action
+  /*/
+  struct sample {
+    uint64_t ns = 0;       // - Wall time of the native action, stand-in overhead included
+    uint64_t reads = 0;    // - Store lookups and iterator steps
+    uint64_t writes = 0;   // - Row stores, updates and removals
+    uint64_t rows = 0;     // - Distinct rows read or written
+    int64_t  bytes = 0;    // - Packed row bytes added (payload only; the chain bills a per-row overhead on top)
+    bool     ok = true;    // - Whether every check passed
+  };
+
+  // - Runs and measures one action
+  template <typename F>
+  sample measure(std::vector<name> signers, F&& body) {
+    auto start = std::chrono::steady_clock::now();
+    bool ok = act(std::move(signers), std::forward<F>(body));
+    auto stop = std::chrono::steady_clock::now();
+
+    const host::usage& used = host::chain().used;
+    sample result;
+    result.ns = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+    result.reads = used.reads;
+    result.writes = used.writes;
+    result.rows = used.touched.size();
+    result.bytes = used.byte_delta;
+    result.ok = ok;
+    return result;
+  }
+
+  /*/
+  Samples of one operation, summarized as means, maxima and a p99
+  /*/
+  struct series {
+    std::string name;
+    std::vector<sample> samples;
+
+    void add(const sample& s) { samples.push_back(s); }
+
+    template <typename Field>
+    double mean(Field field) const {
+      if (samples.empty()) return 0;
+      double total = 0;
+      for (const auto& s : samples) total += static_cast<double>(s.*field);
+      return total / samples.size();
+    }
+
+    template <typename Field>
+    int64_t max(Field field) const {
+      int64_t best = 0;
+      for (const auto& s : samples) best = std::max(best, static_cast<int64_t>(s.*field));
+      return best;
+    }
+
+    template <typename Field>
+    int64_t p99(Field field) const {
+      if (samples.empty()) return 0;
+      std::vector<int64_t> values;
+      for (const auto& s : samples) values.push_back(static_cast<int64_t>(s.*field));
+      std::sort(values.begin(), values.end());
+      return values[std::min(values.size() - 1, values.size() * 99 / 100)];
+    }
+  };
+
+  inline void print_header() {
+    std::printf("%-24s %8s %10s %9s %9s %9s %9s %10s\n", "operation", "count", "ns/op", "reads/op", "writes/op", "rows p99", "rows max", "bytes/op");
+  }
+
+  inline void print_series(const series& s) {
+    std::printf("%-24s %8zu %10.0f %9.1f %9.1f %9lld %9lld %10.1f\n", s.name.c_str(), s.samples.size(),
+                s.mean(&sample::ns), s.mean(&sample::reads), s.mean(&sample::writes),
+                static_cast<long long>(s.p99(&sample::rows)), static_cast<long long>(s.max(&sample::rows)),
+                s.mean(&sample::bytes));
+  }
+
+  /*/
+  Contract settings a run starts from
+  /*/
+  struct setup {
+    uint16_t max_depth = 5;
+    uint32_t rate_seconds = 60;
+    uint16_t burst = 1;
+    bool     lazy_scores = false;
+    uint16_t leaderboard_size = 0;
+    uint16_t stats_shards = 0;
+    uint16_t adopter_scopes = 0;
+    bool     pool_mode = false;
+  };
+
+  // - Clears the host and deploys a configured contract at GENESIS
+  inline void boot(const setup& params) {
+    host::chain() = host::chain_state{};
+    host::set_time(GENESIS);
+    for (name account : {SELF, ADMIN, TOKEN}) host::create_account(account, 0);
+
+    must({SELF}, [&](invitono& c) {
+      c.setconfig(ADMIN, 0, params.rate_seconds, true, params.max_depth, 100, TOKEN, eosio::symbol("TONO", 6), 100);
+    });
+    must({ADMIN}, [&](invitono& c) { c.setlimiter(params.burst, params.rate_seconds); });
+    if (params.lazy_scores) must({ADMIN}, [&](invitono& c) { c.setscoring(true); });
+    if (params.leaderboard_size > 0) must({ADMIN}, [&](invitono& c) { c.setboard(params.leaderboard_size, true); });
+    if (params.stats_shards > 0) must({ADMIN}, [&](invitono& c) { c.setshards(params.stats_shards); });
+    if (params.adopter_scopes > 0) must({ADMIN}, [&](invitono& c) { c.setscopes(params.adopter_scopes); });
+    if (params.pool_mode) must({ADMIN}, [&](invitono& c) { c.setpoolmode(true); });
+  }
+
+  // - Creates an account old enough to register
+  inline name new_account(uint64_t index) {
+    name account = user_name(index);
+    host::create_account(account, 0);
+    return account;
+  }
+
+  inline void advance(uint32_t seconds) {
+    host::set_time(host::now() + seconds);
+  }
+
+} // namespace bench
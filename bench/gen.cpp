@@ -0,0 +1,216 @@
+// === Referral Graph Generator === //
+// --- Feeds synthetic invite sequences through the native contract and reports tail cost per redeeminvite --- //
+
+#include <random>
+#include "fixture.hpp"
+
+using namespace bench;
+
+namespace {
+
+  /*/
+  Generator knobs, all settable as --name value
+  /*/
+  struct options {
+    uint64_t users = 100000;     // - Users to register
+    uint64_t seed = 1;
+    double   chain = 0.10;       // - Chance the newest user invites next, growing long thin chains
+    double   burst = 0.02;       // - Chance an invite starts a burst from the same inviter
+    uint32_t burst_size = 8;     // - Invites in a burst, sent without waiting
+    double   claim = 0.05;       // - Chance of a claimreward by a random member after each invite
+    uint32_t gap = 20;           // - Seconds between invites
+    uint32_t rate = 600;         // - Seconds to refill one invite token
+    uint16_t burst_cap = 4;      // - Invite bucket size
+    uint16_t depth = 5;          // - Credited referral depth
+    bool     lazy = false;       // - Lazy scoring
+    uint16_t board = 0;          // - Leaderboard size
+    uint16_t shards = 0;         // - Stats shards
+    uint16_t scopes = 0;         // - Adopter scopes
+    bool     pool = false;       // - Pool mode
+  };
+
+  /*/
+  Counts of one metric, kept as a histogram so 10^7 samples fit in memory
+  /*/
+  struct histogram {
+    std::map<uint64_t, uint64_t> counts;
+    uint64_t total = 0;
+    double   sum = 0;
+
+    void add(uint64_t value) {
+      counts[value]++;
+      total++;
+      sum += value;
+    }
+
+    double mean() const { return total == 0 ? 0 : sum / total; }
+    uint64_t max() const { return counts.empty() ? 0 : counts.rbegin()->first; }
+
+    uint64_t percentile(double p) const {
+      uint64_t rank = static_cast<uint64_t>(p * total), seen = 0;
+      for (const auto& [value, count] : counts) {
+        seen += count;
+        if (seen > rank) return value;
+      }
+      return max();
+    }
+  };
+
+  /*/
+  Tail cost of one operation
+  /*/
+  struct op_stats {
+    histogram rows;
+    histogram reads;
+    histogram writes;
+    double    ns = 0;
+
+    void add(const sample& s) {
+      rows.add(s.rows);
+      reads.add(s.reads);
+      writes.add(s.writes);
+      ns += s.ns;
+    }
+  };
+
+  void print_op(const std::string& label, const op_stats& op) {
+    auto triple = [](const histogram& h) {
+      char text[48];
+      std::snprintf(text, sizeof(text), "%6.1f %5llu %5llu", h.mean(), static_cast<unsigned long long>(h.percentile(0.99)), static_cast<unsigned long long>(h.max()));
+      return std::string(text);
+    };
+    std::printf("%-14s %9llu %9.0f   %s   %s   %s\n", label.c_str(), static_cast<unsigned long long>(op.rows.total),
+                op.rows.total ? op.ns / op.rows.total : 0.0, triple(op.rows).c_str(), triple(op.reads).c_str(), triple(op.writes).c_str());
+  }
+
+  options parse(int argc, char** argv) {
+    options opts;
+    for (int i = 1; i + 1 < argc; i += 2) {
+      std::string flag = argv[i];
+      double value = std::stod(argv[i + 1]);
+      if (flag == "--users") opts.users = static_cast<uint64_t>(value);
+      else if (flag == "--seed") opts.seed = static_cast<uint64_t>(value);
+      else if (flag == "--chain") opts.chain = value;
+      else if (flag == "--burst") opts.burst = value;
+      else if (flag == "--burst-size") opts.burst_size = static_cast<uint32_t>(value);
+      else if (flag == "--claim") opts.claim = value;
+      else if (flag == "--gap") opts.gap = static_cast<uint32_t>(value);
+      else if (flag == "--rate") opts.rate = static_cast<uint32_t>(value);
+      else if (flag == "--burst-cap") opts.burst_cap = static_cast<uint16_t>(value);
+      else if (flag == "--depth") opts.depth = static_cast<uint16_t>(value);
+      else if (flag == "--lazy") opts.lazy = value != 0;
+      else if (flag == "--board") opts.board = static_cast<uint16_t>(value);
+      else if (flag == "--shards") opts.shards = static_cast<uint16_t>(value);
+      else if (flag == "--scopes") opts.scopes = static_cast<uint16_t>(value);
+      else if (flag == "--pool") opts.pool = value != 0;
+      else {
+        std::fprintf(stderr, "unknown flag %s\n", flag.c_str());
+        std::exit(2);
+      }
+    }
+    return opts;
+  }
+
+} // namespace
+
+int main(int argc, char** argv) {
+  options opts = parse(argc, argv);
+  std::mt19937_64 rng(opts.seed);
+  std::uniform_real_distribution<double> chance(0, 1);
+
+  setup params;
+  params.max_depth = opts.depth;
+  params.rate_seconds = opts.rate;
+  params.burst = opts.burst_cap;
+  params.lazy_scores = opts.lazy;
+  params.leaderboard_size = opts.board;
+  params.stats_shards = opts.shards;
+  params.adopter_scopes = opts.scopes;
+  params.pool_mode = opts.pool;
+  boot(params);
+
+  // - Members by join order; attach holds each member once plus once per invitee, so a uniform pick from it
+  // - chooses inviters in proportion to their fan-out + 1 (preferential attachment, a power-law fan-out)
+  std::vector<name> members;
+  std::vector<uint32_t> attach, depth, fanout;
+  members.reserve(opts.users);
+  depth.reserve(opts.users);
+  fanout.reserve(opts.users);
+
+  op_stats invites, claims;
+  uint64_t rate_limited = 0, unclaimable = 0, queued = 0;
+  uint64_t next_report = 1000;
+
+  std::printf("%-14s %9s %9s   %-18s   %-18s   %-18s\n", "", "count", "ns/op", "rows mean/p99/max", "reads mean/p99/max", "writes mean/p99/max");
+
+  uint64_t next_user = 0;
+  while (next_user < opts.users) {
+    // - Pick an inviter: the newest member (chain), or one by preferential attachment
+    uint32_t inviter_index = UINT32_MAX;
+    if (!members.empty()) {
+      inviter_index = chance(rng) < opts.chain ? members.size() - 1 : attach[rng() % attach.size()];
+    }
+    name inviter = inviter_index == UINT32_MAX ? SELF : members[inviter_index];
+    uint32_t burst = !members.empty() && chance(rng) < opts.burst ? opts.burst_size : 1;
+
+    advance(opts.gap);
+    for (uint32_t b = 0; b < burst && next_user < opts.users; b++) {
+      name user = new_account(next_user);
+      sample s = measure({user}, [&](invitono& c) { c.redeeminvite(user, inviter); });
+      if (!s.ok) {
+        // - Invites past the bucket are expected; anything else is a bug in the contract or the generator
+        if (host::chain().error.find("🥁") != 0) {
+          std::fprintf(stderr, "redeeminvite %s <- %s failed: %s\n", user.to_string().c_str(), inviter.to_string().c_str(), host::chain().error.c_str());
+          return 2;
+        }
+        rate_limited++;
+        continue;
+      }
+      invites.add(s);
+
+      uint32_t index = members.size();
+      members.push_back(user);
+      depth.push_back(inviter_index == UINT32_MAX ? 0 : depth[inviter_index] + 1);
+      fanout.push_back(0);
+      attach.push_back(index);
+      if (inviter_index != UINT32_MAX) {
+        fanout[inviter_index]++;
+        attach.push_back(inviter_index);
+      }
+      next_user++;
+
+      // - Mixed claim traffic, with the payout crank run as the queue fills
+      if (chance(rng) < opts.claim) {
+        name claimer = members[rng() % members.size()];
+        sample c = measure({claimer}, [&](invitono& contract) { contract.claimreward(claimer); });
+        if (c.ok) {
+          claims.add(c);
+          queued++;
+        } else {
+          unclaimable++;
+        }
+        if (queued >= access::MAX_PAYOUT_ITEMS) {
+          must({}, [&](invitono& contract) { contract.processq(access::MAX_PAYOUT_ITEMS); });
+          queued = 0;
+        }
+      }
+
+      // - Tail cost so far at each power of ten
+      if (members.size() == next_report) {
+        print_op(std::to_string(next_report) + " users", invites);
+        next_report *= 10;
+      }
+    }
+  }
+
+  uint32_t deepest = depth.empty() ? 0 : *std::max_element(depth.begin(), depth.end());
+  uint32_t widest = fanout.empty() ? 0 : *std::max_element(fanout.begin(), fanout.end());
+
+  std::printf("\n");
+  print_op("redeeminvite", invites);
+  print_op("claimreward", claims);
+  std::printf("\nusers %zu, deepest chain %u, widest fan-out %u\n", members.size(), deepest, widest);
+  std::printf("rate-limited invites %llu, claims with nothing to pay %llu\n",
+              static_cast<unsigned long long>(rate_limited), static_cast<unsigned long long>(unclaimable));
+  return 0;
+}
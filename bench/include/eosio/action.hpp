@@ -0,0 +1,33 @@
+#pragma once
+#include <vector>
+#include "datastream.hpp"
+#include "host.hpp"
+
+// === Action Stand-In === //
+// --- Inline actions are recorded on the host, not dispatched --- //
+
+namespace eosio {
+
+  struct action {
+    name account;
+    name name_;
+    std::vector<permission_level> authorization;
+    std::vector<char> data;
+
+    template <typename T>
+    action(const permission_level& auth, name a, name n, T&& value)
+      : account(a), name_(n), authorization{auth}, data(pack(std::forward<T>(value))) {}
+
+    template <typename T>
+    action(std::vector<permission_level> auths, name a, name n, T&& value)
+      : account(a), name_(n), authorization(std::move(auths)), data(pack(std::forward<T>(value))) {}
+
+    void send() const {
+      host::chain().sent.push_back(host::sent_action{account, name_, authorization, data});
+    }
+  };
+
+  template <typename... Args>
+  void print(Args&&...) {}
+
+} // namespace eosio
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "check.hpp"
+
+// === Asset Stand-In === //
+// --- Symbols and amounts with the CDT's raw encoding --- //
+
+namespace eosio {
+
+  struct symbol_code {
+    uint64_t value = 0;
+
+    constexpr symbol_code() = default;
+    constexpr explicit symbol_code(uint64_t raw) : value(raw) {}
+
+    constexpr uint64_t raw() const { return value; }
+
+    std::string to_string() const {
+      std::string str;
+      for (uint64_t v = value; v > 0; v >>= 8) str += static_cast<char>(v & 0xff);
+      return str;
+    }
+  };
+
+  struct symbol {
+    uint64_t value = 0;
+
+    constexpr symbol() = default;
+    constexpr explicit symbol(uint64_t raw) : value(raw) {}
+
+    // - Precision in the low byte, code characters above it
+    constexpr symbol(std::string_view code, uint8_t precision) : value(precision) {
+      for (size_t i = 0; i < code.size() && i < 7; i++) value |= static_cast<uint64_t>(code[i]) << (8 * (i + 1));
+    }
+
+    constexpr uint8_t precision() const { return static_cast<uint8_t>(value & 0xff); }
+    constexpr symbol_code code() const { return symbol_code(value >> 8); }
+    constexpr uint64_t raw() const { return value; }
+    constexpr bool is_valid() const { return (value >> 8) != 0; }
+
+    friend constexpr bool operator==(const symbol& a, const symbol& b) { return a.value == b.value; }
+    friend constexpr bool operator!=(const symbol& a, const symbol& b) { return a.value != b.value; }
+    friend constexpr bool operator<(const symbol& a, const symbol& b) { return a.value < b.value; }
+  };
+
+  struct asset {
+    static constexpr int64_t max_amount = (1LL << 62) - 1;
+
+    int64_t amount = 0;
+    eosio::symbol symbol;
+
+    asset() = default;
+    asset(int64_t a, eosio::symbol s) : amount(a), symbol(s) {}
+
+    bool is_amount_within_range() const { return -max_amount <= amount && amount <= max_amount; }
+    bool is_valid() const { return is_amount_within_range() && symbol.is_valid(); }
+
+    asset& operator+=(const asset& other) {
+      check(symbol == other.symbol, "attempt to add asset with different symbol");
+      amount += other.amount;
+      check(is_amount_within_range(), "addition overflow");
+      return *this;
+    }
+
+    std::string to_string() const {
+      std::string digits = std::to_string(amount < 0 ? -amount : amount);
+      uint8_t precision = symbol.precision();
+      if (precision > 0) {
+        if (digits.size() <= precision) digits.insert(0, precision + 1 - digits.size(), '0');
+        digits.insert(digits.size() - precision, ".");
+      }
+      return (amount < 0 ? "-" : "") + digits + " " + symbol.code().to_string();
+    }
+
+    friend bool operator==(const asset& a, const asset& b) { return a.amount == b.amount && a.symbol == b.symbol; }
+    friend bool operator!=(const asset& a, const asset& b) { return !(a == b); }
+  };
+
+} // namespace eosio
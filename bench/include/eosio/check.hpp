@@ -0,0 +1,22 @@
+#pragma once
+#include <stdexcept>
+#include <string>
+
+// === Check Stand-In === //
+// --- A failed check aborts the action by throwing; host::transact rolls its writes back --- //
+
+namespace eosio {
+
+  struct check_failure : std::runtime_error {
+    using std::runtime_error::runtime_error;
+  };
+
+  inline void check(bool pred, const char* msg) {
+    if (!pred) throw check_failure(msg);
+  }
+
+  inline void check(bool pred, const std::string& msg) {
+    if (!pred) throw check_failure(msg);
+  }
+
+} // namespace eosio
@@ -0,0 +1,23 @@
+#pragma once
+#include "datastream.hpp"
+#include "name.hpp"
+
+// === Contract Stand-In === //
+
+namespace eosio {
+
+  class contract {
+  public:
+    contract(name receiver, name code, datastream<const char*> ds) : _self(receiver), _first_receiver(code), _ds(ds) {}
+
+    name get_self() const { return _self; }
+    name get_first_receiver() const { return _first_receiver; }
+    datastream<const char*>& get_datastream() { return _ds; }
+
+  protected:
+    name _self;
+    name _first_receiver;
+    datastream<const char*> _ds;
+  };
+
+} // namespace eosio
@@ -0,0 +1,228 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "asset.hpp"
+#include "check.hpp"
+#include "crypto.hpp"
+#include "name.hpp"
+#include "reflect.hpp"
+#include "time.hpp"
+#include "types.hpp"
+#include "varint.hpp"
+
+// === Datastream Stand-In === //
+// --- Byte-compatible with the CDT's pack/unpack, so row sizes and Merkle leaves match the chain --- //
+
+namespace eosio {
+
+  template <typename Stream>
+  struct datastream {
+    Stream pos;
+    Stream end;
+
+    datastream(Stream start, size_t size) : pos(start), end(start + size) {}
+
+    size_t remaining() const { return end - pos; }
+  };
+
+  namespace detail {
+
+    template <typename T> struct is_vector : std::false_type {};
+    template <typename T, typename A> struct is_vector<std::vector<T, A>> : std::true_type {};
+
+    template <typename T> struct is_array : std::false_type {};
+    template <typename T, size_t N> struct is_array<std::array<T, N>> : std::true_type {};
+
+    template <typename T> struct is_optional : std::false_type {};
+    template <typename T> struct is_optional<std::optional<T>> : std::true_type {};
+
+    template <typename T> struct is_pair : std::false_type {};
+    template <typename A, typename B> struct is_pair<std::pair<A, B>> : std::true_type {};
+
+    template <typename T> struct is_tuple : std::false_type {};
+    template <typename... T> struct is_tuple<std::tuple<T...>> : std::true_type {};
+
+    template <typename T> struct is_map : std::false_type {};
+    template <typename K, typename V, typename C, typename A> struct is_map<std::map<K, V, C, A>> : std::true_type {};
+
+    // - Fixed-width values copied byte for byte (little-endian, as on WASM)
+    template <typename T>
+    constexpr bool is_raw = std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_same_v<T, uint128_t> || std::is_same_v<T, __int128>;
+
+    struct writer {
+      std::vector<char>& out;
+
+      void bytes(const void* data, size_t size) {
+        const char* begin = static_cast<const char*>(data);
+        out.insert(out.end(), begin, begin + size);
+      }
+
+      void varuint(uint64_t value) {
+        do {
+          uint8_t byte = value & 0x7f;
+          value >>= 7;
+          out.push_back(static_cast<char>(byte | (value > 0 ? 0x80 : 0)));
+        } while (value > 0);
+      }
+
+      template <typename T>
+      void operator()(const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+          out.push_back(value ? 1 : 0);
+        } else if constexpr (is_raw<T>) {
+          bytes(&value, sizeof(T));
+        } else if constexpr (std::is_same_v<T, name>) {
+          bytes(&value.value, sizeof(uint64_t));
+        } else if constexpr (std::is_same_v<T, unsigned_int>) {
+          varuint(value.value);
+        } else if constexpr (std::is_same_v<T, symbol> || std::is_same_v<T, symbol_code>) {
+          bytes(&value.value, sizeof(uint64_t));
+        } else if constexpr (std::is_same_v<T, asset>) {
+          (*this)(value.amount);
+          (*this)(value.symbol);
+        } else if constexpr (std::is_same_v<T, checksum256>) {
+          bytes(value.bytes.data(), value.bytes.size());
+        } else if constexpr (std::is_same_v<T, time_point>) {
+          (*this)(value.elapsed.count());
+        } else if constexpr (std::is_same_v<T, time_point_sec>) {
+          (*this)(value.utc_seconds);
+        } else if constexpr (std::is_same_v<T, microseconds>) {
+          (*this)(value.count());
+        } else if constexpr (std::is_same_v<T, std::string>) {
+          varuint(value.size());
+          bytes(value.data(), value.size());
+        } else if constexpr (is_vector<T>::value || is_map<T>::value) {
+          varuint(value.size());
+          for (const auto& item : value) (*this)(item);
+        } else if constexpr (is_array<T>::value) {
+          for (const auto& item : value) (*this)(item);
+        } else if constexpr (is_optional<T>::value) {
+          (*this)(value.has_value());
+          if (value) (*this)(*value);
+        } else if constexpr (is_pair<T>::value) {
+          (*this)(value.first);
+          (*this)(value.second);
+        } else if constexpr (is_tuple<T>::value) {
+          std::apply([&](const auto&... items) { ((*this)(items), ...); }, value);
+        } else {
+          static_assert(std::is_aggregate_v<T>, "No serializer for this type");
+          reflect::for_each_field(value, *this);
+        }
+      }
+    };
+
+    struct reader {
+      datastream<const char*>& ds;
+
+      void bytes(void* data, size_t size) {
+        check(ds.remaining() >= size, "datastream attempted to read past the end");
+        std::memcpy(data, ds.pos, size);
+        ds.pos += size;
+      }
+
+      uint64_t varuint() {
+        uint64_t value = 0;
+        for (uint32_t shift = 0;; shift += 7) {
+          check(shift < 64, "varuint too long");
+          uint8_t byte = 0;
+          bytes(&byte, 1);
+          value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+          if (!(byte & 0x80)) return value;
+        }
+      }
+
+      template <typename T>
+      void operator()(T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+          uint8_t byte = 0;
+          bytes(&byte, 1);
+          value = byte != 0;
+        } else if constexpr (is_raw<T>) {
+          bytes(&value, sizeof(T));
+        } else if constexpr (std::is_same_v<T, name>) {
+          bytes(&value.value, sizeof(uint64_t));
+        } else if constexpr (std::is_same_v<T, unsigned_int>) {
+          value.value = static_cast<uint32_t>(varuint());
+        } else if constexpr (std::is_same_v<T, symbol> || std::is_same_v<T, symbol_code>) {
+          bytes(&value.value, sizeof(uint64_t));
+        } else if constexpr (std::is_same_v<T, asset>) {
+          (*this)(value.amount);
+          (*this)(value.symbol);
+        } else if constexpr (std::is_same_v<T, checksum256>) {
+          bytes(value.bytes.data(), value.bytes.size());
+        } else if constexpr (std::is_same_v<T, time_point>) {
+          int64_t count = 0;
+          (*this)(count);
+          value = time_point(microseconds(count));
+        } else if constexpr (std::is_same_v<T, time_point_sec>) {
+          (*this)(value.utc_seconds);
+        } else if constexpr (std::is_same_v<T, microseconds>) {
+          (*this)(value._count);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+          value.resize(varuint());
+          bytes(value.data(), value.size());
+        } else if constexpr (is_vector<T>::value) {
+          value.resize(varuint());
+          for (auto& item : value) (*this)(item);
+        } else if constexpr (is_map<T>::value) {
+          value.clear();
+          for (uint64_t count = varuint(); count > 0; count--) {
+            std::pair<typename T::key_type, typename T::mapped_type> item;
+            (*this)(item);
+            value.insert(std::move(item));
+          }
+        } else if constexpr (is_array<T>::value) {
+          for (auto& item : value) (*this)(item);
+        } else if constexpr (is_optional<T>::value) {
+          bool present = false;
+          (*this)(present);
+          value.reset();
+          if (present) (*this)(value.emplace());
+        } else if constexpr (is_pair<T>::value) {
+          (*this)(value.first);
+          (*this)(value.second);
+        } else if constexpr (is_tuple<T>::value) {
+          std::apply([&](auto&... items) { ((*this)(items), ...); }, value);
+        } else {
+          static_assert(std::is_aggregate_v<T>, "No serializer for this type");
+          reflect::for_each_field(value, *this);
+        }
+      }
+    };
+
+  } // namespace detail
+
+  template <typename T>
+  std::vector<char> pack(const T& value) {
+    std::vector<char> out;
+    detail::writer{out}(value);
+    return out;
+  }
+
+  template <typename T>
+  size_t pack_size(const T& value) {
+    return pack(value).size();
+  }
+
+  template <typename T>
+  T unpack(const char* data, size_t size) {
+    T value{};
+    datastream<const char*> ds(data, size);
+    detail::reader{ds}(value);
+    return value;
+  }
+
+  template <typename T>
+  T unpack(const std::vector<char>& bytes) {
+    return unpack<T>(bytes.data(), bytes.size());
+  }
+
+} // namespace eosio
@@ -0,0 +1,21 @@
+#pragma once
+#include "action.hpp"
+#include "asset.hpp"
+#include "check.hpp"
+#include "contract.hpp"
+#include "crypto.hpp"
+#include "datastream.hpp"
+#include "multi_index.hpp"
+#include "name.hpp"
+#include "permission.hpp"
+#include "system.hpp"
+#include "time.hpp"
+#include "types.hpp"
+#include "varint.hpp"
+
+// === Umbrella Stand-In === //
+// --- Contract attribute macros; the attributes themselves are ignored natively (-Wno-attributes) --- //
+
+#define CONTRACT class [[eosio::contract]]
+#define ACTION [[eosio::action]] void
+#define TABLE struct [[eosio::table]]
@@ -0,0 +1,164 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "check.hpp"
+#include "name.hpp"
+
+// === Host Stand-In === //
+// --- In-memory chain state: tables, accounts, clock, authorizations and per-action usage --- //
+
+namespace eosio {
+
+  struct permission_level {
+    name actor;
+    name permission;
+
+    permission_level(name a = {}, name p = {}) : actor(a), permission(p) {}
+
+    friend bool operator==(const permission_level& a, const permission_level& b) {
+      return a.actor == b.actor && a.permission == b.permission;
+    }
+  };
+
+} // namespace eosio
+
+namespace host {
+
+  using eosio::name;
+
+  /*/
+  One (code, scope, table) triple
+  /*/
+  struct table_id {
+    uint64_t code;
+    uint64_t scope;
+    uint64_t table;
+
+    friend bool operator<(const table_id& a, const table_id& b) {
+      return std::tie(a.code, a.scope, a.table) < std::tie(b.code, b.scope, b.table);
+    }
+  };
+
+  /*/
+  Packed rows of one table, the account billed for each, and its typed secondary keys by index number
+  /*/
+  struct table_store {
+    std::map<uint64_t, std::vector<char>> rows;
+    std::map<uint64_t, uint64_t> payers;
+    std::map<size_t, std::shared_ptr<void>> indexes;
+  };
+
+  // - RAM the chain bills per row on top of its packed bytes (approximate; secondary index entries aren't counted)
+  static constexpr int64_t ROW_OVERHEAD = 112;
+
+  /*/
+  An inline action recorded instead of dispatched
+  /*/
+  struct sent_action {
+    name account;
+    name action;
+    std::vector<eosio::permission_level> authorization;
+    std::vector<char> data;
+  };
+
+  /*/
+  Database work done by the current action
+  /*/
+  struct usage {
+    uint64_t reads = 0;       // - Row lookups and iterator steps that reached the store
+    uint64_t writes = 0;      // - Row stores, updates and removals
+    int64_t  row_delta = 0;   // - Rows added less rows removed
+    int64_t  byte_delta = 0;  // - Packed row bytes added less bytes removed
+    std::set<std::tuple<uint64_t, uint64_t, uint64_t, uint64_t>> touched; // - Distinct (code, scope, table, key) rows read or written
+    std::map<std::pair<uint64_t, uint64_t>, int64_t> ram;                 // - RAM bytes billed per (code, payer), less bytes refunded
+  };
+
+  /*/
+  Everything a native action sees of the chain
+  /*/
+  struct chain_state {
+    int64_t now_us = 0;
+    std::vector<eosio::permission_level> auths;
+    std::map<uint64_t, uint32_t> accounts;  // - Account to creation time (seconds)
+    std::map<table_id, table_store> tables;
+    std::vector<sent_action> sent;
+    usage used;
+    std::vector<std::function<void()>> undo;
+    std::string error;
+  };
+
+  inline chain_state& chain() {
+    static chain_state state;
+    return state;
+  }
+
+  inline table_store& table(name code, uint64_t scope, name table) {
+    return chain().tables[table_id{code.value, scope, table.value}];
+  }
+
+  inline void touch(const table_id& id, uint64_t key) {
+    chain().used.touched.emplace(id.code, id.scope, id.table, key);
+  }
+
+  inline void bill(uint64_t code, uint64_t payer, int64_t bytes) {
+    chain().used.ram[{code, payer}] += bytes;
+  }
+
+  // - The chain's RAM rule: a contract may grow its own RAM, or another account's only if that account signed
+  inline void check_ram_payers() {
+    chain_state& state = chain();
+    for (const auto& [billed, bytes] : state.used.ram) {
+      const auto& [code, payer] = billed;
+      if (bytes <= 0 || payer == code) continue;
+      bool signed_by_payer = std::any_of(state.auths.begin(), state.auths.end(), [&](const eosio::permission_level& level) {
+        return level.actor.value == payer;
+      });
+      eosio::check(signed_by_payer, "unprivileged contract cannot increase RAM usage of another account that has not authorized the action: " + name(payer).to_string());
+    }
+  }
+
+  inline void set_time(uint32_t seconds) {
+    chain().now_us = static_cast<int64_t>(seconds) * 1000000;
+  }
+
+  inline uint32_t now() {
+    return static_cast<uint32_t>(chain().now_us / 1000000);
+  }
+
+  inline void create_account(name account, uint32_t created) {
+    chain().accounts[account.value] = created;
+  }
+
+  // - Runs one action with the given authorizations; a failed check rolls its writes back and returns false
+  template <typename F>
+  bool transact(std::vector<eosio::permission_level> auths, F&& action) {
+    chain_state& state = chain();
+    state.auths = std::move(auths);
+    state.used = usage{};
+    state.undo.clear();
+    state.sent.clear();
+    state.error.clear();
+
+    bool ok = true;
+    try {
+      action();
+      check_ram_payers();
+    } catch (const eosio::check_failure& failure) {
+      for (auto itr = state.undo.rbegin(); itr != state.undo.rend(); ++itr) (*itr)();
+      state.sent.clear();
+      state.error = failure.what();
+      ok = false;
+    }
+    state.undo.clear();
+    state.auths.clear();
+    return ok;
+  }
+
+} // namespace host
@@ -0,0 +1,378 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <tuple>
+#include <utility>
+#include "check.hpp"
+#include "datastream.hpp"
+#include "host.hpp"
+#include "name.hpp"
+
+// === Multi Index Stand-In === //
+// --- Rows live packed in the host store; each table object caches what it loaded, like the CDT's --- //
+
+namespace eosio {
+
+  template <typename Object, typename Key, Key (Object::*Fun)() const>
+  struct const_mem_fun {
+    using result_type = Key;
+    Key operator()(const Object& object) const { return (object.*Fun)(); }
+  };
+
+  template <name::raw IndexName, typename Extractor>
+  struct indexed_by {
+    static constexpr name::raw index_name = IndexName;
+    using secondary_extractor_type = Extractor;
+  };
+
+  template <name::raw TableName, typename T, typename... Indices>
+  class multi_index {
+  public:
+    using keys_type = std::tuple<typename Indices::secondary_extractor_type::result_type...>;
+
+    template <size_t I>
+    using key_type = std::tuple_element_t<I, keys_type>;
+
+    template <size_t I>
+    using key_set = std::set<std::pair<key_type<I>, uint64_t>>;
+
+    // === Primary Iterator === //
+
+    class const_iterator {
+    public:
+      const_iterator() = default;
+      const_iterator(const multi_index* table, std::optional<uint64_t> key) : _table(table), _key(key) {}
+
+      const T& operator*() const { return _table->load(*_key); }
+      const T* operator->() const { return &_table->load(*_key); }
+
+      const_iterator& operator++() {
+        check(_key.has_value(), "cannot increment end iterator");
+        host::chain().used.reads++;
+        auto next = _table->_store->rows.upper_bound(*_key);
+        _key = next == _table->_store->rows.end() ? std::nullopt : std::optional<uint64_t>(next->first);
+        return *this;
+      }
+
+      const_iterator& operator--() {
+        host::chain().used.reads++;
+        auto& rows = _table->_store->rows;
+        auto prev = _key ? rows.lower_bound(*_key) : rows.end();
+        check(prev != rows.begin(), "cannot decrement iterator at beginning of table");
+        _key = (--prev)->first;
+        return *this;
+      }
+
+      const_iterator operator++(int) {
+        const_iterator copy = *this;
+        ++*this;
+        return copy;
+      }
+
+      friend bool operator==(const const_iterator& a, const const_iterator& b) { return a._key == b._key; }
+      friend bool operator!=(const const_iterator& a, const const_iterator& b) { return a._key != b._key; }
+
+    private:
+      friend class multi_index;
+      const multi_index* _table = nullptr;
+      std::optional<uint64_t> _key;
+    };
+
+    // === Secondary Index === //
+
+    template <size_t I>
+    class index {
+    public:
+      using entry = std::pair<key_type<I>, uint64_t>;
+
+      class const_iterator {
+      public:
+        const_iterator() = default;
+        const_iterator(const multi_index* table, std::optional<entry> pos) : _table(table), _pos(pos) {}
+
+        const T& operator*() const { return _table->load(_pos->second); }
+        const T* operator->() const { return &_table->load(_pos->second); }
+
+        const_iterator& operator++() {
+          check(_pos.has_value(), "cannot increment end iterator");
+          host::chain().used.reads++;
+          auto& keys = _table->template keys<I>();
+          auto next = keys.upper_bound(*_pos);
+          _pos = next == keys.end() ? std::nullopt : std::optional<entry>(*next);
+          return *this;
+        }
+
+        friend bool operator==(const const_iterator& a, const const_iterator& b) { return a._pos == b._pos; }
+        friend bool operator!=(const const_iterator& a, const const_iterator& b) { return a._pos != b._pos; }
+
+      private:
+        friend class index;
+        const multi_index* _table = nullptr;
+        std::optional<entry> _pos;
+      };
+
+      explicit index(multi_index* table) : _table(table) {}
+
+      const_iterator begin() const {
+        host::chain().used.reads++;
+        auto& keys = _table->template keys<I>();
+        return at(keys.begin());
+      }
+
+      const_iterator end() const { return const_iterator(_table, std::nullopt); }
+
+      template <typename K>
+      const_iterator lower_bound(const K& key) const {
+        host::chain().used.reads++;
+        auto& keys = _table->template keys<I>();
+        return at(keys.lower_bound(entry(key_type<I>(key), 0)));
+      }
+
+      template <typename K>
+      const_iterator upper_bound(const K& key) const {
+        host::chain().used.reads++;
+        auto& keys = _table->template keys<I>();
+        return at(keys.upper_bound(entry(key_type<I>(key), UINT64_MAX)));
+      }
+
+      template <typename K>
+      const_iterator find(const K& key) const {
+        const_iterator itr = lower_bound(key);
+        if (itr != end() && itr._pos->first == key_type<I>(key)) return itr;
+        return end();
+      }
+
+      const_iterator iterator_to(const T& object) const {
+        return const_iterator(_table, entry(extract(object), object.primary_key()));
+      }
+
+      template <typename Lambda>
+      void modify(const_iterator itr, name payer, Lambda&& updater) {
+        _table->modify(*itr, payer, std::forward<Lambda>(updater));
+      }
+
+      const_iterator erase(const_iterator itr) {
+        const_iterator next = itr;
+        ++next;
+        _table->erase(*itr);
+        return next;
+      }
+
+    private:
+      multi_index* _table;
+
+      static key_type<I> extract(const T& object) {
+        using extractor = typename std::tuple_element_t<I, std::tuple<Indices...>>::secondary_extractor_type;
+        return extractor{}(object);
+      }
+
+      const_iterator at(typename key_set<I>::const_iterator itr) const {
+        auto& keys = _table->template keys<I>();
+        return const_iterator(_table, itr == keys.end() ? std::nullopt : std::optional<entry>(*itr));
+      }
+    };
+
+    // === Table === //
+
+    multi_index(name code, uint64_t scope)
+      : _code(code), _scope(scope), _id{code.value, scope, static_cast<uint64_t>(TableName)},
+        _store(&host::table(code, scope, name(TableName))) {}
+
+    name get_code() const { return _code; }
+    uint64_t get_scope() const { return _scope; }
+
+    const_iterator begin() const {
+      host::chain().used.reads++;
+      return at(_store->rows.begin());
+    }
+
+    const_iterator end() const { return const_iterator(this, std::nullopt); }
+
+    const_iterator lower_bound(uint64_t key) const {
+      host::chain().used.reads++;
+      return at(_store->rows.lower_bound(key));
+    }
+
+    const_iterator upper_bound(uint64_t key) const {
+      host::chain().used.reads++;
+      return at(_store->rows.upper_bound(key));
+    }
+
+    // - Cached rows are found without reaching the store, as in the CDT
+    const_iterator find(uint64_t key) const {
+      if (_cache.count(key)) return const_iterator(this, key);
+      host::chain().used.reads++;
+      return at(_store->rows.find(key));
+    }
+
+    const_iterator require_find(uint64_t key, const char* error_msg = "unable to find key") const {
+      const_iterator itr = find(key);
+      check(itr != end(), error_msg);
+      return itr;
+    }
+
+    const T& get(uint64_t key, const char* error_msg = "unable to find key") const {
+      return *require_find(key, error_msg);
+    }
+
+    const_iterator iterator_to(const T& object) const { return const_iterator(this, object.primary_key()); }
+
+    uint64_t available_primary_key() const {
+      host::chain().used.reads++;
+      return _store->rows.empty() ? 0 : _store->rows.rbegin()->first + 1;
+    }
+
+    template <name::raw IndexName>
+    auto get_index() const {
+      constexpr size_t I = index_number<IndexName>();
+      return index<I>(const_cast<multi_index*>(this));
+    }
+
+    template <typename Lambda>
+    const_iterator emplace(name payer, Lambda&& constructor) {
+      check(payer != name(), "must specify a valid account to pay for new record");
+
+      auto object = std::make_unique<T>();
+      constructor(*object);
+      uint64_t key = object->primary_key();
+      check(!_store->rows.count(key), "could not insert object, most likely a uniqueness constraint was violated");
+
+      store(key, std::nullopt, pack(*object), std::nullopt, key_tuple(*object), payer);
+      _cache[key] = std::move(object);
+      return const_iterator(this, key);
+    }
+
+    template <typename Lambda>
+    void modify(const_iterator itr, name payer, Lambda&& updater) {
+      check(itr != end(), "cannot pass end iterator to modify");
+      modify(*itr, payer, std::forward<Lambda>(updater));
+    }
+
+    template <typename Lambda>
+    void modify(const T& object, name payer, Lambda&& updater) {
+      uint64_t key = object.primary_key();
+      T& mutable_object = const_cast<T&>(object);
+      auto old_keys = key_tuple(object);
+      auto old_bytes = _store->rows.at(key);
+
+      updater(mutable_object);
+      check(mutable_object.primary_key() == key, "updater cannot change primary key when modifying an object");
+
+      store(key, std::move(old_bytes), pack(mutable_object), std::move(old_keys), key_tuple(mutable_object), payer);
+    }
+
+    const_iterator erase(const_iterator itr) {
+      check(itr != end(), "cannot pass end iterator to erase");
+      const_iterator next = itr;
+      ++next;
+      erase(*itr);
+      return next;
+    }
+
+    void erase(const T& object) {
+      uint64_t key = object.primary_key();
+      auto old_keys = key_tuple(object);
+      store(key, _store->rows.at(key), std::nullopt, std::move(old_keys), std::nullopt, name());
+      _cache.erase(key);
+    }
+
+  private:
+    name _code;
+    uint64_t _scope;
+    host::table_id _id;
+    host::table_store* _store;
+
+    // - Loaded rows by primary key; pointers stay valid until the row is erased
+    mutable std::map<uint64_t, std::unique_ptr<T>> _cache;
+
+    template <name::raw IndexName, size_t I = 0>
+    static constexpr size_t index_number() {
+      static_assert(I < sizeof...(Indices), "name not provided in index");
+      if constexpr (std::tuple_element_t<I, std::tuple<Indices...>>::index_name == IndexName) {
+        return I;
+      } else {
+        return index_number<IndexName, I + 1>();
+      }
+    }
+
+    template <size_t I>
+    key_set<I>& keys() const {
+      auto& slot = _store->indexes[I];
+      if (!slot) slot = std::make_shared<key_set<I>>();
+      return *std::static_pointer_cast<key_set<I>>(slot);
+    }
+
+    static keys_type key_tuple(const T& object) {
+      return keys_type(typename Indices::secondary_extractor_type{}(object)...);
+    }
+
+    const_iterator at(std::map<uint64_t, std::vector<char>>::const_iterator itr) const {
+      return const_iterator(this, itr == _store->rows.end() ? std::nullopt : std::optional<uint64_t>(itr->first));
+    }
+
+    const T& load(uint64_t key) const {
+      auto cached = _cache.find(key);
+      if (cached != _cache.end()) return *cached->second;
+
+      auto row = _store->rows.find(key);
+      check(row != _store->rows.end(), "row does not exist");
+      host::touch(_id, key);
+      auto object = std::make_unique<T>(unpack<T>(row->second));
+      return *(_cache[key] = std::move(object));
+    }
+
+    // - Replaces a row's bytes and secondary keys (nullopt = absent), counting the write, billing its RAM and logging its undo;
+    // - an empty payer keeps the row's current one
+    void store(uint64_t key, std::optional<std::vector<char>> old_bytes, std::optional<std::vector<char>> new_bytes,
+               std::optional<keys_type> old_keys, std::optional<keys_type> new_keys, name payer) {
+      host::usage& used = host::chain().used;
+      used.writes++;
+      used.row_delta += (new_bytes ? 1 : 0) - (old_bytes ? 1 : 0);
+      used.byte_delta += static_cast<int64_t>(new_bytes ? new_bytes->size() : 0) - static_cast<int64_t>(old_bytes ? old_bytes->size() : 0);
+      host::touch(_id, key);
+
+      // - The old payer is refunded the old row and the new payer billed the new one, as the chain does
+      uint64_t old_payer = old_bytes ? _store->payers.at(key) : 0;
+      uint64_t new_payer = payer == name() ? old_payer : payer.value;
+      if (old_bytes) host::bill(_id.code, old_payer, -(static_cast<int64_t>(old_bytes->size()) + host::ROW_OVERHEAD));
+      if (new_bytes) host::bill(_id.code, new_payer, static_cast<int64_t>(new_bytes->size()) + host::ROW_OVERHEAD);
+
+      apply(_store, key, new_bytes, new_payer, old_keys, new_keys);
+      host::chain().undo.push_back([target = _store, key, old_bytes, old_payer, old_keys, new_keys]() {
+        apply(target, key, old_bytes, old_payer, new_keys, old_keys);
+      });
+    }
+
+    // - Works on the store alone, so the undo log can outlive this table object
+    static void apply(host::table_store* target, uint64_t key, const std::optional<std::vector<char>>& bytes, uint64_t payer,
+                      const std::optional<keys_type>& remove, const std::optional<keys_type>& add) {
+      if (bytes) {
+        target->rows[key] = *bytes;
+        target->payers[key] = payer;
+      } else {
+        target->rows.erase(key);
+        target->payers.erase(key);
+      }
+      update_keys(target, key, remove, add, std::index_sequence_for<Indices...>{});
+    }
+
+    template <size_t... I>
+    static void update_keys(host::table_store* target, uint64_t key, const std::optional<keys_type>& remove,
+                            const std::optional<keys_type>& add, std::index_sequence<I...>) {
+      (update_key<I>(target, key, remove, add), ...);
+    }
+
+    template <size_t I>
+    static void update_key(host::table_store* target, uint64_t key, const std::optional<keys_type>& remove, const std::optional<keys_type>& add) {
+      auto& slot = target->indexes[I];
+      if (!slot) slot = std::make_shared<key_set<I>>();
+      auto& keys = *std::static_pointer_cast<key_set<I>>(slot);
+      if (remove) keys.erase({std::get<I>(*remove), key});
+      if (add) keys.insert({std::get<I>(*add), key});
+    }
+  };
+
+} // namespace eosio
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// === Name Stand-In === //
+// --- Base32 account names with the same encoding as the CDT --- //
+
+namespace eosio {
+
+  struct name {
+    enum class raw : uint64_t {};
+
+    uint64_t value = 0;
+
+    constexpr name() = default;
+    constexpr explicit name(uint64_t v) : value(v) {}
+    constexpr name(raw r) : value(static_cast<uint64_t>(r)) {}
+
+    // - Up to 12 characters of 5 bits and a 13th of 4 bits, first character highest
+    constexpr explicit name(std::string_view str) : value(0) {
+      size_t length = str.size() < 13 ? str.size() : 13;
+      for (size_t i = 0; i < length && i < 12; i++) {
+        value |= (static_cast<uint64_t>(char_to_value(str[i])) & 0x1f) << (64 - 5 * (i + 1));
+      }
+      if (length == 13) value |= static_cast<uint64_t>(char_to_value(str[12])) & 0x0f;
+    }
+
+    static constexpr uint8_t char_to_value(char c) {
+      if (c == '.') return 0;
+      if (c >= '1' && c <= '5') return static_cast<uint8_t>(c - '1' + 1);
+      if (c >= 'a' && c <= 'z') return static_cast<uint8_t>(c - 'a' + 6);
+      return 0;
+    }
+
+    constexpr operator raw() const { return raw(value); }
+    constexpr explicit operator bool() const { return value != 0; }
+
+    std::string to_string() const {
+      static const char* charmap = ".12345abcdefghijklmnopqrstuvwxyz";
+      std::string str(13, '.');
+      uint64_t tmp = value;
+      for (uint32_t i = 0; i <= 12; i++) {
+        str[12 - i] = charmap[tmp & (i == 0 ? 0x0f : 0x1f)];
+        tmp >>= (i == 0 ? 4 : 5);
+      }
+      while (!str.empty() && str.back() == '.') str.pop_back();
+      return str;
+    }
+
+    friend constexpr bool operator==(const name& a, const name& b) { return a.value == b.value; }
+    friend constexpr bool operator!=(const name& a, const name& b) { return a.value != b.value; }
+    friend constexpr bool operator<(const name& a, const name& b) { return a.value < b.value; }
+    friend constexpr bool operator>(const name& a, const name& b) { return a.value > b.value; }
+    friend constexpr bool operator<=(const name& a, const name& b) { return a.value <= b.value; }
+    friend constexpr bool operator>=(const name& a, const name& b) { return a.value >= b.value; }
+  };
+
+} // namespace eosio
+
+// - "alice"_n, as a GNU string literal operator template like the CDT's
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+template <typename T, T... Str>
+inline constexpr eosio::name operator""_n() {
+  constexpr const char chars[] = {Str...};
+  return eosio::name(std::string_view(chars, sizeof...(Str)));
+}
+#pragma GCC diagnostic pop
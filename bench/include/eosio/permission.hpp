@@ -0,0 +1,39 @@
+#pragma once
+#include <algorithm>
+#include "check.hpp"
+#include "host.hpp"
+#include "time.hpp"
+
+// === Permission Stand-In === //
+// --- Authorizations come from host::transact, accounts from host::create_account --- //
+
+namespace eosio {
+
+  static constexpr name same_payer{};
+
+  inline bool has_auth(name account) {
+    const auto& auths = host::chain().auths;
+    return std::any_of(auths.begin(), auths.end(), [&](const permission_level& level) { return level.actor == account; });
+  }
+
+  inline void require_auth(name account) {
+    check(has_auth(account), "missing authority of " + account.to_string());
+  }
+
+  inline void require_auth(const permission_level& level) {
+    const auto& auths = host::chain().auths;
+    check(std::find(auths.begin(), auths.end(), level) != auths.end(),
+          "missing authority of " + level.actor.to_string() + "/" + level.permission.to_string());
+  }
+
+  inline bool is_account(name account) {
+    return host::chain().accounts.count(account.value) > 0;
+  }
+
+  inline time_point_sec get_account_creation_time(name account) {
+    auto itr = host::chain().accounts.find(account.value);
+    check(itr != host::chain().accounts.end(), "account " + account.to_string() + " does not exist");
+    return time_point_sec(itr->second);
+  }
+
+} // namespace eosio
@@ -0,0 +1,140 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// === Reflection Stand-In === //
+// --- The CDT generates serializers for TABLE structs; natively their aggregate fields are visited in order instead --- //
+
+namespace eosio::reflect {
+
+  // - Converts to any field type, only ever used in unevaluated brace initialization
+  struct any_field {
+    template <typename T>
+    operator T() const;
+  };
+
+  template <typename T, typename Seq, typename = void>
+  struct braces_constructible : std::false_type {};
+
+  template <typename T, std::size_t... I>
+  struct braces_constructible<T, std::index_sequence<I...>, std::void_t<decltype(T{(void(I), any_field{})...})>> : std::true_type {};
+
+  // - Field count: the most initializers the aggregate accepts
+  template <typename T, std::size_t N = 32>
+  constexpr std::size_t field_count() {
+    if constexpr (N == 0) {
+      return 0;
+    } else if constexpr (braces_constructible<T, std::make_index_sequence<N>>::value) {
+      return N;
+    } else {
+      return field_count<T, N - 1>();
+    }
+  }
+
+  // - Calls visit on each field of an aggregate, in declaration order
+  template <typename Object, typename Visit>
+  void for_each_field(Object& object, Visit&& visit) {
+    constexpr std::size_t N = field_count<std::remove_const_t<Object>>();
+    if constexpr (N == 1) {
+      auto& [f0] = object;
+      visit(f0);
+    } else if constexpr (N == 2) {
+      auto& [f0, f1] = object;
+      visit(f0); visit(f1);
+    } else if constexpr (N == 3) {
+      auto& [f0, f1, f2] = object;
+      visit(f0); visit(f1); visit(f2);
+    } else if constexpr (N == 4) {
+      auto& [f0, f1, f2, f3] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3);
+    } else if constexpr (N == 5) {
+      auto& [f0, f1, f2, f3, f4] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4);
+    } else if constexpr (N == 6) {
+      auto& [f0, f1, f2, f3, f4, f5] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5);
+    } else if constexpr (N == 7) {
+      auto& [f0, f1, f2, f3, f4, f5, f6] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6);
+    } else if constexpr (N == 8) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7);
+    } else if constexpr (N == 9) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8);
+    } else if constexpr (N == 10) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9);
+    } else if constexpr (N == 11) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10);
+    } else if constexpr (N == 12) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11);
+    } else if constexpr (N == 13) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12);
+    } else if constexpr (N == 14) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13);
+    } else if constexpr (N == 15) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14);
+    } else if constexpr (N == 16) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15);
+    } else if constexpr (N == 17) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15); visit(f16);
+    } else if constexpr (N == 18) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15); visit(f16); visit(f17);
+    } else if constexpr (N == 19) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, f18] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15); visit(f16); visit(f17); visit(f18);
+    } else if constexpr (N == 20) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, f18, f19] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15); visit(f16); visit(f17); visit(f18); visit(f19);
+    } else if constexpr (N == 21) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, f18, f19, f20] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15); visit(f16); visit(f17); visit(f18); visit(f19); visit(f20);
+    } else if constexpr (N == 22) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, f18, f19, f20, f21] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15); visit(f16); visit(f17); visit(f18); visit(f19); visit(f20); visit(f21);
+    } else if constexpr (N == 23) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, f18, f19, f20, f21, f22] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15); visit(f16); visit(f17); visit(f18); visit(f19); visit(f20); visit(f21); visit(f22);
+    } else if constexpr (N == 24) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, f18, f19, f20, f21, f22, f23] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15); visit(f16); visit(f17); visit(f18); visit(f19); visit(f20); visit(f21); visit(f22); visit(f23);
+    } else if constexpr (N == 25) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15); visit(f16); visit(f17); visit(f18); visit(f19); visit(f20); visit(f21); visit(f22); visit(f23); visit(f24);
+    } else if constexpr (N == 26) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15); visit(f16); visit(f17); visit(f18); visit(f19); visit(f20); visit(f21); visit(f22); visit(f23); visit(f24); visit(f25);
+    } else if constexpr (N == 27) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15); visit(f16); visit(f17); visit(f18); visit(f19); visit(f20); visit(f21); visit(f22); visit(f23); visit(f24); visit(f25); visit(f26);
+    } else if constexpr (N == 28) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15); visit(f16); visit(f17); visit(f18); visit(f19); visit(f20); visit(f21); visit(f22); visit(f23); visit(f24); visit(f25); visit(f26); visit(f27);
+    } else if constexpr (N == 29) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15); visit(f16); visit(f17); visit(f18); visit(f19); visit(f20); visit(f21); visit(f22); visit(f23); visit(f24); visit(f25); visit(f26); visit(f27); visit(f28);
+    } else if constexpr (N == 30) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15); visit(f16); visit(f17); visit(f18); visit(f19); visit(f20); visit(f21); visit(f22); visit(f23); visit(f24); visit(f25); visit(f26); visit(f27); visit(f28); visit(f29);
+    } else if constexpr (N == 31) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29, f30] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15); visit(f16); visit(f17); visit(f18); visit(f19); visit(f20); visit(f21); visit(f22); visit(f23); visit(f24); visit(f25); visit(f26); visit(f27); visit(f28); visit(f29); visit(f30);
+    } else if constexpr (N == 32) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29, f30, f31] = object;
+      visit(f0); visit(f1); visit(f2); visit(f3); visit(f4); visit(f5); visit(f6); visit(f7); visit(f8); visit(f9); visit(f10); visit(f11); visit(f12); visit(f13); visit(f14); visit(f15); visit(f16); visit(f17); visit(f18); visit(f19); visit(f20); visit(f21); visit(f22); visit(f23); visit(f24); visit(f25); visit(f26); visit(f27); visit(f28); visit(f29); visit(f30); visit(f31);
+    } else {
+      static_assert(N <= 32, "Add cases for wider structs");
+    }
+  }
+
+} // namespace eosio::reflect
@@ -0,0 +1,62 @@
+#pragma once
+#include "multi_index.hpp"
+
+// === Singleton Stand-In === //
+// --- One row keyed by the singleton name, stored through multi_index like the CDT's --- //
+
+namespace eosio {
+
+  template <name::raw SingletonName, typename T>
+  class singleton {
+    static constexpr uint64_t pk_value = static_cast<uint64_t>(SingletonName);
+
+    struct row {
+      T value;
+
+      uint64_t primary_key() const { return pk_value; }
+    };
+
+    using table = multi_index<SingletonName, row>;
+
+  public:
+    singleton(name code, uint64_t scope) : _t(code, scope) {}
+
+    bool exists() const { return _t.find(pk_value) != _t.end(); }
+
+    T get() const {
+      auto itr = _t.find(pk_value);
+      check(itr != _t.end(), "singleton does not exist");
+      return itr->value;
+    }
+
+    T get_or_default(const T& def = T()) const {
+      auto itr = _t.find(pk_value);
+      return itr != _t.end() ? itr->value : def;
+    }
+
+    T get_or_create(name payer, const T& def = T()) {
+      auto itr = _t.find(pk_value);
+      if (itr != _t.end()) return itr->value;
+      _t.emplace(payer, [&](row& r) { r.value = def; });
+      return def;
+    }
+
+    void set(const T& value, name payer) {
+      auto itr = _t.find(pk_value);
+      if (itr != _t.end()) {
+        _t.modify(itr, payer, [&](row& r) { r.value = value; });
+      } else {
+        _t.emplace(payer, [&](row& r) { r.value = value; });
+      }
+    }
+
+    void remove() {
+      auto itr = _t.find(pk_value);
+      if (itr != _t.end()) _t.erase(itr);
+    }
+
+  private:
+    table _t;
+  };
+
+} // namespace eosio
@@ -0,0 +1,18 @@
+#pragma once
+#include "host.hpp"
+#include "time.hpp"
+
+// === System Stand-In === //
+// --- Block time from the host clock --- //
+
+namespace eosio {
+
+  inline time_point current_time_point() {
+    return time_point(microseconds(host::chain().now_us));
+  }
+
+  inline time_point_sec current_block_time() {
+    return time_point_sec(current_time_point());
+  }
+
+} // namespace eosio
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+
+// === Time Stand-In === //
+// --- Block time types; the clock itself is host::chain().now --- //
+
+namespace eosio {
+
+  struct microseconds {
+    int64_t _count = 0;
+
+    constexpr microseconds() = default;
+    constexpr explicit microseconds(int64_t c) : _count(c) {}
+    constexpr int64_t count() const { return _count; }
+  };
+
+  struct time_point {
+    microseconds elapsed;
+
+    constexpr time_point() = default;
+    constexpr explicit time_point(microseconds e) : elapsed(e) {}
+    constexpr int64_t time_since_epoch() const { return elapsed.count(); }
+    constexpr uint32_t sec_since_epoch() const { return static_cast<uint32_t>(elapsed.count() / 1000000); }
+  };
+
+  struct time_point_sec {
+    uint32_t utc_seconds = 0;
+
+    constexpr time_point_sec() = default;
+    constexpr explicit time_point_sec(uint32_t seconds) : utc_seconds(seconds) {}
+    constexpr time_point_sec(const time_point& t) : utc_seconds(t.sec_since_epoch()) {}
+    constexpr uint32_t sec_since_epoch() const { return utc_seconds; }
+  };
+
+} // namespace eosio
@@ -0,0 +1,7 @@
+#pragma once
+
+// === Integer Types === //
+// --- The CDT's global 128-bit typedef --- //
+
+typedef unsigned __int128 uint128_t;
+typedef __int128 int128_t;
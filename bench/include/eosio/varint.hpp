@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdint>
+
+// === Varint Stand-In === //
+// --- unsigned_int packs as LEB128 like the CDT's varuint32 --- //
+
+namespace eosio {
+
+  struct unsigned_int {
+    uint32_t value = 0;
+
+    unsigned_int(uint32_t v = 0) : value(v) {}
+
+    operator uint32_t() const { return value; }
+    unsigned_int& operator=(uint32_t v) {
+      value = v;
+      return *this;
+    }
+  };
+
+} // namespace eosio
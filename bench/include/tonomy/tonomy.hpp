@@ -0,0 +1,37 @@
+#pragma once
+#include <eosio/eosio.hpp>
+#include <string>
+
+// === Tonomy Stand-In === //
+// --- Only the apps table the contract reads to resolve an app permission --- //
+
+namespace tonomysystem {
+
+  using eosio::checksum256;
+  using eosio::name;
+
+  class tonomy {
+  public:
+    /*/
+    A registered Tonomy app, with the same columns as the system contract's apps table
+    /*/
+    struct app {
+      name        account_name;
+      std::string app_name;
+      checksum256 username_hash;
+      std::string description;
+      std::string logo_url;
+      std::string origin;
+
+      uint64_t primary_key() const { return account_name.value; }
+      checksum256 index_by_username_hash() const { return username_hash; }
+      checksum256 index_by_origin_hash() const { return eosio::sha256(origin.data(), origin.size()); }
+    };
+
+    using apps_table = eosio::multi_index<"apps"_n, app,
+      eosio::indexed_by<"usernamehash"_n, eosio::const_mem_fun<app, checksum256, &app::index_by_username_hash>>,
+      eosio::indexed_by<"originhash"_n, eosio::const_mem_fun<app, checksum256, &app::index_by_origin_hash>>
+    >;
+  };
+
+} // namespace tonomysystem
@@ -0,0 +1,272 @@
+// === Invitono Workloads === //
+// --- Replays scripted invite and claim patterns and checks their table cost against stored budgets --- //
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include "fixture.hpp"
+
+using namespace bench;
+
+namespace {
+
+  /*/
+  One scripted workload and the operations it measured
+  /*/
+  struct workload {
+    std::string name;
+    std::vector<series> ops;
+  };
+
+  // - Registers user under inviter, waiting out the inviter's bucket first
+  sample invite(name user, name inviter, uint32_t wait) {
+    advance(wait);
+    sample s = measure({user}, [&](invitono& c) { c.redeeminvite(user, inviter); });
+    if (!s.ok) {
+      std::fprintf(stderr, "redeeminvite %s <- %s failed: %s\n", user.to_string().c_str(), inviter.to_string().c_str(), host::chain().error.c_str());
+      std::exit(2);
+    }
+    return s;
+  }
+
+  // - Each user invites the next, at the deepest configurable referral depth
+  workload deep_chain(uint32_t users) {
+    setup params;
+    params.max_depth = access::MAX_REFERRAL_DEPTH;
+    boot(params);
+
+    series redeem{"redeeminvite"};
+    name inviter = SELF;
+    for (uint32_t i = 0; i < users; i++) {
+      name user = new_account(i);
+      redeem.add(invite(user, inviter, params.rate_seconds));
+      inviter = user;
+    }
+    return workload{"deep-chain", {redeem}};
+  }
+
+  // - One inviter registers every user, one refill interval apart
+  workload wide_fan(uint32_t users) {
+    setup params;
+    boot(params);
+
+    name root = new_account(0);
+    invite(root, SELF, 0);
+
+    series redeem{"redeeminvite"};
+    for (uint32_t i = 1; i <= users; i++) {
+      redeem.add(invite(new_account(i), root, params.rate_seconds));
+    }
+    return workload{"wide-fan", {redeem}};
+  }
+
+  // - A five-level tree where every member claims at once, then the payout crank drains the queue
+  workload claim_storm(uint32_t users) {
+    setup params;
+    params.leaderboard_size = 10;
+    boot(params);
+
+    // - Member i is invited by member (i - 1) / 4, so every inviter has four invitees
+    std::vector<name> members;
+    for (uint32_t i = 0; i < users; i++) {
+      name user = new_account(i);
+      invite(user, i == 0 ? SELF : members[(i - 1) / 4], params.rate_seconds);
+      members.push_back(user);
+    }
+
+    series claim{"claimreward"};
+    for (name member : members) {
+      sample s = measure({member}, [&](invitono& c) { c.claimreward(member); });
+      if (!s.ok) {
+        std::fprintf(stderr, "claimreward %s failed: %s\n", member.to_string().c_str(), host::chain().error.c_str());
+        std::exit(2);
+      }
+      claim.add(s);
+    }
+
+    series crank{"processq"};
+    while (true) {
+      sample s = measure({}, [&](invitono& c) { c.processq(access::MAX_PAYOUT_ITEMS); });
+      if (!s.ok) break;
+      crank.add(s);
+    }
+    return workload{"claim-storm", {claim, crank}};
+  }
+
+  // - A baseline-layout chain too deep for one transaction, migrated in bounded calls, then invited under at its deepest user
+  workload legacy_chain(uint32_t users) {
+    setup params;
+    boot(params);
+
+    // - Each legacy user was invited by the previous one
+    must({SELF}, [&](invitono&) {
+      invitono::adopters_table legacy(SELF, SELF.value);
+      for (uint32_t i = 0; i < users; i++) {
+        name user = new_account(i);
+        legacy.emplace(SELF, [&](auto& row) {
+          row.account = user;
+          row.invitedby = i == 0 ? SELF : user_name(i - 1);
+          row.lastupdated = GENESIS;
+        });
+      }
+    });
+
+    // - Until the chain is packed, an invite under its deepest user is turned away instead of walking it
+    name deepest = user_name(users - 1);
+    name late = new_account(users);
+    advance(params.rate_seconds);
+    if (act({late}, [&](invitono& c) { c.redeeminvite(late, deepest); }) || host::chain().error.find("🎵") != 0) {
+      std::fprintf(stderr, "redeeminvite under an unmigrated chain: %s\n", host::chain().error.c_str());
+      std::exit(2);
+    }
+
+    series steps{"migrate"};
+    while (true) {
+      sample s = measure({SELF}, [&](invitono& c) { c.migrate(100); });
+      if (!s.ok) break;
+      steps.add(s);
+    }
+    if (host::chain().error.find("🎵 Nothing left") != 0) {
+      std::fprintf(stderr, "migrate failed: %s\n", host::chain().error.c_str());
+      std::exit(2);
+    }
+
+    series redeem{"redeeminvite"};
+    redeem.add(invite(late, deepest, 0));
+    return workload{"legacy-chain", {steps, redeem}};
+  }
+
+  // - Rows users paid for grow as descendants credit them; the stand-in fails any growth billed to a payer who didn't sign
+  workload user_paid(uint32_t users) {
+    setup params;
+    boot(params);
+
+    // - The root's score passes the one-byte varint range, and its first invitee opens a second level under it
+    name root = new_account(0);
+    invite(root, SELF, 0);
+    series redeem{"redeeminvite"};
+    for (uint32_t i = 1; i <= users; i++) {
+      redeem.add(invite(new_account(i), i % 2 ? root : user_name(1), params.rate_seconds));
+    }
+
+    // - Lazy credit lands as pending on the same rows, then settles without a signer and claims self-signed
+    must({ADMIN}, [&](invitono& c) { c.setscoring(true); });
+    for (uint32_t i = users + 1; i <= 2 * users; i++) {
+      redeem.add(invite(new_account(i), user_name(1), params.rate_seconds));
+    }
+
+    // - Settling user 1 pushes its pending credit into the root's row too
+    series settle{"settle"};
+    name inviter = user_name(1);
+    settle.add(measure({}, [&](invitono& c) { c.settle(inviter); }));
+    if (!settle.samples.back().ok) {
+      std::fprintf(stderr, "settle %s failed: %s\n", inviter.to_string().c_str(), host::chain().error.c_str());
+      std::exit(2);
+    }
+
+    series claim{"claimreward"};
+    for (name user : {root, inviter}) {
+      claim.add(measure({user}, [&](invitono& c) { c.claimreward(user); }));
+      if (!claim.samples.back().ok) {
+        std::fprintf(stderr, "claimreward %s failed: %s\n", user.to_string().c_str(), host::chain().error.c_str());
+        std::exit(2);
+      }
+    }
+    return workload{"user-paid", {redeem, settle, claim}};
+  }
+
+  // - Budgeted metrics of one operation; ns/op is reported but never budgeted, it varies by machine
+  std::vector<std::pair<std::string, double>> metrics(const series& s) {
+    return {
+      {"reads", s.mean(&sample::reads)},
+      {"writes", s.mean(&sample::writes)},
+      {"rows_max", static_cast<double>(s.max(&sample::rows))},
+      {"bytes", s.mean(&sample::bytes)},
+    };
+  }
+
+  // - Budget file lines: workload operation metric max; # starts a comment
+  std::map<std::string, double> load_budgets(const std::string& path) {
+    std::map<std::string, double> budgets;
+    std::ifstream in(path);
+    if (!in) {
+      std::fprintf(stderr, "cannot read budgets from %s\n", path.c_str());
+      std::exit(2);
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+      line = line.substr(0, line.find('#'));
+      std::istringstream fields(line);
+      std::string workload_name, op, metric;
+      double max = 0;
+      if (fields >> workload_name >> op >> metric >> max) budgets[workload_name + " " + op + " " + metric] = max;
+    }
+    return budgets;
+  }
+
+  // - Writes the measured values with 10% headroom as the new budgets
+  void record_budgets(const std::string& path, const std::vector<workload>& runs) {
+    std::ofstream out(path);
+    out << "# workload     operation      metric     max\n";
+    out << "# Recorded by `make budgets` with 10% headroom; counts are deterministic, so any rise is a real change.\n";
+    for (const auto& run : runs) {
+      for (const auto& op : run.ops) {
+        for (const auto& [metric, value] : metrics(op)) {
+          char line[128];
+          std::snprintf(line, sizeof(line), "%-14s %-14s %-10s %.1f\n", run.name.c_str(), op.name.c_str(), metric.c_str(), value + std::abs(value) * 0.1);
+          out << line;
+        }
+      }
+    }
+  }
+
+  // - Prints every metric that has a budget and returns how many exceed it
+  uint32_t check_budgets(const std::map<std::string, double>& budgets, const std::vector<workload>& runs) {
+    uint32_t over = 0;
+    for (const auto& run : runs) {
+      for (const auto& op : run.ops) {
+        for (const auto& [metric, value] : metrics(op)) {
+          auto budget = budgets.find(run.name + " " + op.name + " " + metric);
+          if (budget == budgets.end()) continue;
+          bool exceeded = value > budget->second;
+          over += exceeded;
+          std::printf("%-14s %-14s %-10s %10.1f / %10.1f %s\n", run.name.c_str(), op.name.c_str(), metric.c_str(), value, budget->second, exceeded ? "OVER" : "ok");
+        }
+      }
+    }
+    return over;
+  }
+
+} // namespace
+
+// - Usage: workloads [budgets.txt] [--record]
+int main(int argc, char** argv) {
+  std::string path = argc > 1 ? argv[1] : "budgets.txt";
+  bool record = argc > 2 && std::string(argv[2]) == "--record";
+
+  std::vector<workload> runs{deep_chain(200), wide_fan(500), claim_storm(500), legacy_chain(3000), user_paid(300)};
+
+  print_header();
+  for (const auto& run : runs) {
+    for (const auto& op : run.ops) {
+      series labelled = op;
+      labelled.name = run.name + "/" + op.name;
+      print_series(labelled);
+    }
+  }
+  std::printf("\n");
+
+  if (record) {
+    record_budgets(path, runs);
+    std::printf("budgets written to %s\n", path.c_str());
+    return 0;
+  }
+
+  uint32_t over = check_budgets(load_budgets(path), runs);
+  if (over > 0) {
+    std::printf("\n%u metric(s) over budget\n", over);
+    return 1;
+  }
+  return 0;
+}
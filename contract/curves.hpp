@@ -0,0 +1,74 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <algorithm>
+#include <cstdint>
+
+// === Reward Curves === //
+// --- Compile-time threshold tables mapping a score to a bonus position --- //
+
+namespace curves {
+
+  // - Curve selector stored in config
+  enum curve_type : uint8_t {
+    TETRAHEDRAL = 0,   // - n(n+1)(n+2)/6: 1, 4, 10, 20, ...
+    TRIANGULAR = 1,    // - n(n+1)/2:      1, 3, 6, 10, ...
+    SQUARE = 2,        // - n^2:           1, 4, 9, 16, ...
+    CAPPED_LINEAR = 3  // - n * step, capped at CURVE_SIZE positions
+  };
+
+  // - Number of thresholds per curve (positions 0..CURVE_SIZE)
+  static constexpr size_t CURVE_SIZE = 24;
+
+  // === Series Terms === //
+  // --- n-th threshold for n = 1..CURVE_SIZE --- //
+
+  struct tetrahedral { static constexpr uint32_t term(uint32_t n) { return n * (n + 1) * (n + 2) / 6; } };
+  struct triangular  { static constexpr uint32_t term(uint32_t n) { return n * (n + 1) / 2; } };
+  struct square      { static constexpr uint32_t term(uint32_t n) { return n * n; } };
+
+  // - Builds a curve's threshold table at compile time
+  template <typename Series>
+  constexpr std::array<uint32_t, CURVE_SIZE> make_table() {
+    std::array<uint32_t, CURVE_SIZE> values{};
+    for (size_t i = 0; i < CURVE_SIZE; i++) {
+      values[i] = Series::term(static_cast<uint32_t>(i + 1));
+    }
+    return values;
+  }
+
+  template <typename Series>
+  struct table {
+    static constexpr std::array<uint32_t, CURVE_SIZE> values = make_table<Series>();
+  };
+
+  static_assert(table<tetrahedral>::values[CURVE_SIZE - 1] == 2600, "Tetrahedral table must end at T(24)");
+
+  // - Counts thresholds <= score with a branch-free binary search
+  template <size_t N>
+  constexpr uint32_t position(const std::array<uint32_t, N>& values, uint32_t score) {
+    size_t base = 0;
+    size_t n = N;
+    while (n > 1) {
+      size_t half = n / 2;
+      base = (values[base + half] <= score) ? base + half : base;
+      n -= half;
+    }
+    return static_cast<uint32_t>(base + (values[base] <= score));
+  }
+
+  // - Position of score on the selected curve (step only applies to CAPPED_LINEAR)
+  constexpr uint32_t curve_position(uint8_t curve, uint32_t step, uint32_t score) {
+    switch (curve) {
+      case TRIANGULAR:    return position(table<triangular>::values, score);
+      case SQUARE:        return position(table<square>::values, score);
+      case CAPPED_LINEAR: return step == 0 ? 0 : static_cast<uint32_t>(std::min<uint64_t>(score / step, CURVE_SIZE));
+      default:            return position(table<tetrahedral>::values, score);
+    }
+  }
+
+  static_assert(curve_position(TETRAHEDRAL, 0, 0) == 0 && curve_position(TETRAHEDRAL, 0, 3) == 1 &&
+                curve_position(TETRAHEDRAL, 0, 4) == 2 && curve_position(TETRAHEDRAL, 0, 999999) == CURVE_SIZE,
+                "Tetrahedral positions must match the original series scan");
+
+} // namespace curves
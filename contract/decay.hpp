@@ -0,0 +1,64 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// === Score Decay === //
+// --- Fixed-point half-life decay from a compile-time table --- //
+
+namespace decay {
+
+  // - Table entries per half-life
+  static constexpr size_t STEPS = 64;
+
+  // - 1.0 in Q32
+  static constexpr uint64_t ONE = uint64_t(1) << 32;
+
+  // - ceil(2^(-1/64) * 2^64), one table step in Q64
+  static constexpr uint64_t STEP_FACTOR = 0xfd3e0c0cf486c175ull;
+
+  // - Builds 2^(-i/STEPS) in Q32 for i = 0..STEPS-1 at compile time, rounded up from a Q64 chain
+  constexpr std::array<uint64_t, STEPS> make_factors() {
+    std::array<uint64_t, STEPS> values{};
+    unsigned __int128 value = static_cast<unsigned __int128>(1) << 64;
+    for (size_t i = 0; i < STEPS; i++) {
+      values[i] = static_cast<uint64_t>((value + ONE - 1) >> 32);
+      value = (value * STEP_FACTOR + UINT64_MAX) >> 64;
+    }
+    return values;
+  }
+
+  static constexpr std::array<uint64_t, STEPS> FACTORS = make_factors();
+
+  static_assert(FACTORS[32] == 3037000500ull, "Half a half-life is 2^31.5 rounded up");
+  static_assert((FACTORS[STEPS - 1] * FACTORS[1] + ONE - 1) >> 32 == ONE / 2 + 1, "Table must end one step above a half");
+
+  // - points * 2^(-steps / STEPS), rounded up so decay applied over many touches never falls below the exact value
+  constexpr uint64_t decayed(uint64_t points, uint64_t steps) {
+    if (points == 0 || steps == 0) return points;
+
+    // - Past 48 halvings even a full 40-bit score is gone
+    uint64_t halvings = steps / STEPS;
+    if (halvings >= 48) return 0;
+
+    unsigned __int128 value = static_cast<unsigned __int128>(points) * FACTORS[steps % STEPS];
+    unsigned __int128 unit = static_cast<unsigned __int128>(1) << (32 + halvings);
+    return static_cast<uint64_t>((value + unit - 1) >> (32 + halvings));
+  }
+
+  // - Applies decayed one touch at a time, as a row touched every steps_per_touch steps sees it
+  constexpr uint64_t decayed_by_touches(uint64_t points, uint64_t touches, uint64_t steps_per_touch) {
+    for (uint64_t i = 0; i < touches; i++) points = decayed(points, steps_per_touch);
+    return points;
+  }
+
+  static_assert(decayed(1000 << 8, 0) == 1000 << 8, "No time, no decay");
+  static_assert(decayed(1000 << 8, STEPS) == 500 << 8, "One half-life halves the score");
+  static_assert(decayed(1000 << 8, STEPS / 2) >> 8 == 707, "Half a half-life keeps 1/sqrt(2)");
+  static_assert(decayed(uint64_t(UINT32_MAX) << 8, 48 * STEPS) == 0, "48 half-lives empty any score");
+  static_assert(decayed_by_touches(10 << 8, STEPS, 1) >> 8 == 5, "A touch every step still halves 10 points to 5");
+  static_assert(decayed_by_touches(100 << 8, STEPS, 1) >> 8 == 50, "A touch every step still halves 100 points to 50");
+  static_assert(decayed_by_touches(100 << 8, 16, 4) >> 8 == 50, "Touches every 4 steps halve 100 points to 50");
+  static_assert(decayed_by_touches(1000 << 8, 2, STEPS) == 250 << 8, "Whole half-lives are exact");
+
+} // namespace decay
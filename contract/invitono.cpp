@@ -1,5 +1,20 @@
 #include "invitono.hpp"
 
+// === Destructor === //
+// --- Writes back the leaderboard, pool and score total once per action --- //
+
+invitono::~invitono() {
+  if (_score_delta != 0) flush_score();
+  if (_board_dirty) {
+    leaderboard_table board(get_self(), get_self().value);
+    board.set(*_board, get_self());
+  }
+  if (_pool_dirty) {
+    pool_table pools(get_self(), get_self().value);
+    pools.set(*_pool, get_self());
+  }
+}//END ~invitono()
+
 // === Register User === //
 // --- Registers a user with a referral code and applies multi-level scoring --- //
 
@@ -7,98 +22,346 @@ void invitono::redeeminvite(name user, name inviter) {
   // - Authorization check
   check(has_auth(user) || has_auth(get_self()) || has_tonomy_auth(user), "🎵 Only you, the contract, or Tonomy ID can redeem this invite");
 
+  // - Configuration check
+  const contract_config& cfg = current_config();
+  check(cfg.enabled, "🎺 Sorry, registration is paused right now");
+
+  // - Invite validation
+  uint32_t now = current_time_point().sec_since_epoch();
+  const adopterv2* inviter_row = check_invite(user, inviter, cfg, now);
+
+  // - Rate limit check for inviter
+  if (inviter_row) {
+    check_invite_rate(*inviter_row, 1, cfg, now);
+  }
+
+  // - Create new user record, billed to the user when they signed (the chain won't bill an account that didn't)
+  std::vector<name> upline = add_adopter(user, inviter, inviter_row, now, has_auth(user) ? user : get_self());
+
+  // - Update referral scores with the inviter's token spent in the same write, or only count the invite in lazy mode
+  if (!cfg.lazy_scores) {
+    update_scores(upline, cfg.max_referral_depth, 1, now, 1, 1);
+  } else if (inviter_row) {
+    update_adopter(*inviter_row, [&](auto& row) {
+      row.take_invites(1, cfg.invite_burst, cfg.invite_rate_seconds, now);
+      row.pending.value += 1;
+      row.add_descendants(1, 1);
+      row.lastupdated = now;
+    });
+  }
+
+  // - Update global statistics, with the score change in the same shard write
+  add_stats({user}, now);
+}//END redeeminvite()
+
+// === Register Batch === //
+// --- Registers many users with one config read, one stats write and combined upline updates --- //
+
+void invitono::redeembatch(std::vector<invite> invites) {
+  check(!invites.empty(), "🎼 No invites in this batch");
+
+  // - Configuration check
+  const contract_config& cfg = current_config();
+  check(cfg.enabled, "🎺 Sorry, registration is paused right now");
+
+  uint32_t now = current_time_point().sec_since_epoch();
+
+  // - Combined score increments per ancestor, split by level for the histograms
+  struct credit {
+    uint32_t total = 0;
+    std::vector<uint32_t> levels;
+
+    void add(uint32_t level) {
+      if (levels.size() < level) levels.resize(level);
+      levels[level - 1] += 1;
+      total += 1;
+    }
+  };
+  std::map<name, credit> increments;
+
+  // - Invites per inviter, spent from their buckets with the increments
+  std::map<name, uint32_t> spent;
+
+  for (const auto& [user, inviter] : invites) {
+    // - Authorization check
+    check(has_auth(user) || has_auth(get_self()) || has_tonomy_auth(user), "🎵 Only you, the contract, or Tonomy ID can redeem this invite");
+
+    // - Invite validation
+    const adopterv2* inviter_row = check_invite(user, inviter, cfg, now);
+
+    // - Rate limit check, counting invites already made in this batch
+    if (inviter_row) {
+      check_invite_rate(*inviter_row, ++spent[inviter], cfg, now);
+    }
+
+    // - Create new user record; users who didn't sign the batch are billed to the contract
+    std::vector<name> upline = add_adopter(user, inviter, inviter_row, now, has_auth(user) ? user : get_self());
+
+    // - Collect upline increments, or only the inviter's in lazy mode
+    if (cfg.lazy_scores) {
+      if (!upline.empty()) increments[upline[0]].add(1);
+      continue;
+    }
+    uint32_t level = 0;
+    for (const auto& ancestor : collect_upline(upline, cfg.max_referral_depth)) {
+      increments[ancestor].add(++level);
+    }
+  }
+
+  // - Apply each ancestor's combined increment once
+  for (const auto& [account, increment] : increments) {
+    const adopterv2* ancestor = find_adopter(account);
+    if (!ancestor) continue;
+
+    update_adopter(*ancestor, [&](auto& row) {
+      if (cfg.lazy_scores) row.pending.value += increment.total;
+      auto invites_sent = spent.find(account);
+      if (invites_sent != spent.end()) row.take_invites(invites_sent->second, cfg.invite_burst, cfg.invite_rate_seconds, now);
+      for (uint32_t level = 1; level <= increment.levels.size(); level++) {
+        uint32_t count = increment.levels[level - 1];
+        if (count == 0) continue;
+        if (!cfg.lazy_scores) row.add_points(count, level_weight(cfg, level));
+        row.add_descendants(level, count);
+      }
+      row.lastupdated = now;
+    });
+  }
+
+  // - Update global statistics once per touched shard, with the score change in the first user's
+  std::vector<name> users;
+  users.reserve(invites.size());
+  for (const auto& entry : invites) users.push_back(entry.user);
+  add_stats(users, now);
+}//END redeembatch()
+
+// === Check Invite === //
+// --- Validates accounts, registration status and account age --- //
+
+const invitono::adopterv2* invitono::check_invite(name user, name inviter, const contract_config& cfg, uint32_t now) {
   // - Account validation
   check(is_account(inviter), "🎸 This inviter account doesn't exist");
   check(user != inviter, "🎹 You can't invite yourself");
 
   // - Registration status check
-  adopters_table adopters(get_self(), get_self().value);
-  auto existing = adopters.find(user.value);
-  check(existing == adopters.end(), "🎤 You're already registered with us");
+  check(!find_adopter(user), "🎤 You're already registered with us");
 
   // - Inviter validation
-  auto inviter_itr = adopters.find(inviter.value);
-  check(inviter_itr != adopters.end() || inviter == get_self(), "🎷 Your inviter needs to join first");
-
-  // - Configuration check
-  config_table conf(get_self(), get_self().value);
-  auto cfg = conf.get_or_default();
-  check(cfg.enabled, "🎺 Sorry, registration is paused right now");
+  const adopterv2* inviter_row = inviter == get_self() ? nullptr : find_adopter(inviter);
+  check(inviter_row || inviter == get_self(), "🎷 Your inviter needs to join first");
 
   // - Account age verification
-  time_point_sec now = time_point_sec(current_time_point());
-  
-  // - Rate limit check for inviter
-  if (inviter != get_self()) {
-    uint32_t time_elapsed = now.sec_since_epoch() - inviter_itr->lastupdated;
-    if (time_elapsed < cfg.invite_rate_seconds) {
-      check(false, "🥁 Your inviter needs to wait " + std::to_string(cfg.invite_rate_seconds - time_elapsed) + " seconds before inviting again");
-    }
-  }
-  
   time_point_sec creation_date = get_account_creation_time(user);
-  check((now.sec_since_epoch() - creation_date.sec_since_epoch()) >= cfg.min_account_age_days * 86400,
+  check((now - creation_date.sec_since_epoch()) >= cfg.min_account_age_days * 86400,
         "🎻 Your account needs to be at least " + std::to_string(cfg.min_account_age_days) + " days old");
 
-  // - Create new user record
-  adopters.emplace(user, [&](auto& row) {
-    row.account = user;
-    row.invitedby = inviter;
-    row.lastupdated = current_time_point().sec_since_epoch();
-    row.score = 1;
-    row.claimed = false;
+  return inviter_row;
+}//END check_invite()
+
+// === Check Invite Rate === //
+// --- Refills a copy of the inviter's token bucket and checks it covers count invites --- //
+
+void invitono::check_invite_rate(const adopterv2& inviter_row, uint32_t count, const contract_config& cfg, uint32_t now) {
+  check(count <= cfg.invite_burst, "🥁 Your inviter can send at most " + std::to_string(cfg.invite_burst) + " invites at once");
+
+  adopterv2 bucket = inviter_row;
+  if (!bucket.take_invites(count, cfg.invite_burst, cfg.invite_rate_seconds, now)) {
+    uint32_t wait = bucket.bucket_updated + cfg.invite_rate_seconds - now;
+    check(false, "🥁 Your inviter needs to wait " + std::to_string(wait) + " seconds before inviting again");
+  }
+}//END check_invite_rate()
+
+// === Add Adopter === //
+// --- Creates a new user record with its upline path and jump pointers --- //
+
+std::vector<name> invitono::add_adopter(name user, name inviter, const adopterv2* inviter_row, uint32_t now, name payer, uint32_t score, uint8_t flags) {
+  adopterv2 row;
+  row.account = user;
+  row.invitedby = inviter;
+  row.lastupdated = now;
+  row.score = score;
+  row.flags = flags;
+
+  // - The bucket starts empty, so a new inviter waits one refill as with the original cooldown
+  row.bucket_updated = now;
+
+  link_upline(row, inviter_row);
+
+  const contract_config& cfg = current_config();
+  row.set_indexed(cfg.index_scores);
+
+  // - New rows earn only from funding that arrives after they join
+  row.checkpoint = current_pool().reward_per_score;
+
+  auto itr = adopters_for(user).emplace(payer, [&](auto& packed) {
+    packed = row;
   });
+  track_score(user, score);
+  track_leader(*itr, cfg);
 
-  // - Update global statistics
-  stats_table stats(get_self(), get_self().value);
-  auto current = stats.get_or_default();
-  current.total_users += 1;
-  current.total_referrals += 1;
-  current.last_registered = user;
-  stats.set(current, get_self());
+  return row.upline;
+}//END add_adopter()
 
-  // - Update referral scores
-  update_scores(inviter);
-}//END redeeminvite()
+// === Link Upline === //
+// --- Upline is the inviter followed by the inviter's own path; jumps come from the ancestors' jumps --- //
+
+void invitono::link_upline(adopterv2& row, const adopterv2* inviter_row) {
+  if (!inviter_row) return;
+
+  row.upline.reserve(MAX_UPLINE);
+  row.upline.push_back(inviter_row->account);
+  for (const auto& ancestor : inviter_row->upline) {
+    if (row.upline.size() >= MAX_UPLINE) break;
+    row.upline.push_back(ancestor);
+  }
+  row.depth = inviter_row->depth.value + 1;
+
+  // - Jump 2^k is jump 2^(k-1) of the 2^(k-1)-th ancestor; only those past the path are stored
+  for (uint32_t k = row.path_jumps(); (1u << k) <= row.depth.value; k++) {
+    const adopterv2* mid = find_adopter(row.jump(k - 1));
+    if (!mid || mid->jump_count() < k) break;
+    row.jumps.push_back(mid->jump(k - 1));
+  }
+}//END link_upline()
+
+// === Collect Upline === //
+// --- Continues past the stored path using the last ancestor's own path --- //
+
+std::vector<name> invitono::collect_upline(const std::vector<name>& upline, uint16_t depth) {
+    std::vector<name> ancestors(upline.begin(), upline.begin() + std::min<size_t>(upline.size(), depth));
+
+    // - A full path may continue; one lookup per MAX_UPLINE levels beyond it
+    bool more = upline.size() == MAX_UPLINE;
+    while (more && ancestors.size() < depth) {
+        // - Continue from the furthest ancestor still stored; pruned ones keep their level in the path
+        size_t from = ancestors.size();
+        const adopterv2* last = nullptr;
+        while (from > 0 && !(last = find_adopter(ancestors[from - 1]))) from--;
+        if (!last) break;
+
+        // - Its path repeats the ancestors after it, so skip those
+        size_t skip = ancestors.size() - from;
+        if (last->upline.size() <= skip) break;
+        for (size_t i = skip; i < last->upline.size() && ancestors.size() < depth; i++) {
+            ancestors.push_back(last->upline[i]);
+        }
+        more = last->upline.size() == MAX_UPLINE;
+    }
+    return ancestors;
+}//END collect_upline()
+
+// === Kth Ancestor === //
+// --- Uses the stored path when it reaches, otherwise the largest jump that fits --- //
+
+name invitono::kth_ancestor(name account, uint32_t k) {
+    const adopterv2* row = find_adopter(account);
+    if (!row || k > row->depth.value) return name{};
+
+    while (k > 0) {
+        if (k <= row->upline.size()) return row->upline[k - 1];
+        if (row->jump_count() == 0) return name{};
+
+        uint32_t bit = std::min<uint32_t>(31 - __builtin_clz(k), row->jump_count() - 1);
+        name target = row->jump(bit);
+        row = find_adopter(target);
+        check(row, "🎻 " + target.to_string() + " was removed, so this path can't be followed past it");
+        k -= 1u << bit;
+    }
+    return row->account;
+}//END kth_ancestor()
+
+// === Lowest Common Ancestor === //
+// --- Lifts the deeper account to equal depth, then jumps both while they differ --- //
+
+name invitono::lowest_common_ancestor(name a, name b) {
+    const adopterv2* a_row = find_adopter(a);
+    const adopterv2* b_row = find_adopter(b);
+    if (!a_row || !b_row) return name{};
+
+    // - Bring both accounts to the same depth; a removed row on the way fails rather than reading as separate trees
+    auto lift = [&](name account, uint32_t k) {
+        name ancestor = kth_ancestor(account, k);
+        const adopterv2* row = find_adopter(ancestor);
+        check(row, "🎻 " + ancestor.to_string() + " was removed, so this path can't be followed past it");
+        return row;
+    };
+    if (a_row->depth.value > b_row->depth.value) {
+        a_row = lift(a, a_row->depth.value - b_row->depth.value);
+    } else if (b_row->depth.value > a_row->depth.value) {
+        b_row = lift(b, b_row->depth.value - a_row->depth.value);
+    }
+    if (a_row->account == b_row->account) return a_row->account;
+
+    // - Largest jumps first, moving only while the targets differ
+    for (uint32_t k = std::min(a_row->jump_count(), b_row->jump_count()); k-- > 0;) {
+        if (k >= a_row->jump_count() || k >= b_row->jump_count()) continue;
+        if (a_row->jump(k) == b_row->jump(k)) continue;
+
+        name a_jump = a_row->jump(k);
+        name b_jump = b_row->jump(k);
+        a_row = find_adopter(a_jump);
+        b_row = find_adopter(b_jump);
+        check(a_row, "🎻 " + a_jump.to_string() + " was removed, so this path can't be followed past it");
+        check(b_row, "🎻 " + b_jump.to_string() + " was removed, so this path can't be followed past it");
+    }
+
+    // - Parents now match unless the accounts sit in separate trees
+    if (a_row->depth.value == 0 || a_row->invitedby != b_row->invitedby) return name{};
+    return a_row->invitedby;
+}//END lowest_common_ancestor()
 
 // === Update Scores === //
-// --- Applies +1 score to inviter and their upline if cooldown has passed --- //
+// --- Applies increment to each ancestor up to depth --- //
 
-void invitono::update_scores(name direct_inviter) {
-    // - Initialize tables
-    adopters_table adopters(get_self(), get_self().value);
-    config_table conf(get_self(), get_self().value);
-    auto cfg = conf.get_or_default();
-
-    // - Skip if inviter is contract account
-    if (direct_inviter == get_self()) return;
-
-    // - Build upline chain
-    std::vector<std::pair<name, uint16_t>> upline;
-    uint16_t current_level = 1;
-
-    // - Traverse referral chain up to max depth
-    auto current_itr = adopters.find(direct_inviter.value);
-    while (current_itr != adopters.end() && current_level <= cfg.max_referral_depth) {
-        upline.push_back({current_itr->account, current_level});
-        
-        if (current_itr->invitedby == name{}) break;
-        current_itr = adopters.find(current_itr->invitedby.value);
-        current_level++;
-    }
-
-    // - Update scores with level multipliers
-    for (const auto& [account, level] : upline) {
-        auto itr = adopters.find(account.value);
-        if (itr != adopters.end()) {
-            adopters.modify(itr, same_payer, [&](auto& row) {
-                row.score += 1;
-                row.lastupdated = current_time_point().sec_since_epoch();
+void invitono::update_scores(const std::vector<name>& upline, uint16_t depth, uint32_t increment, uint32_t now, uint16_t level, uint32_t spend) {
+    const contract_config& cfg = current_config();
+
+    // - Ancestors are nearest first, so each step up is one level further from the new users
+    for (const auto& ancestor : collect_upline(upline, depth)) {
+        const adopterv2* ancestor_row = find_adopter(ancestor);
+        if (ancestor_row) {
+            update_adopter(*ancestor_row, [&](auto& row) {
+                // - The nearest ancestor's rate-limit tokens, in the same write as its credit
+                if (spend > 0 && ancestor == upline.front()) row.take_invites(spend, cfg.invite_burst, cfg.invite_rate_seconds, now);
+                row.add_points(increment, level_weight(cfg, level));
+                row.add_descendants(level, increment);
+                row.lastupdated = now;
             });
         }
+        level++;
     }
 }//END update_scores()
 
+// === Settle Pending === //
+// --- Credits deferred direct invites: level 1 to the row, levels 2+ to its upline --- //
+
+void invitono::settle_pending(const adopterv2& user_row, const contract_config& cfg, uint32_t now) {
+    uint32_t pending = user_row.pending.value;
+    if (pending == 0) return;
+
+    // - Invitees sit one level below the row, so its upline covers levels 2..max
+    update_scores(user_row.upline, cfg.max_referral_depth - 1, pending, now, 2);
+
+    // - The row's own level 1 count was taken when each invite arrived
+    update_adopter(user_row, [&](auto& row) {
+        row.add_points(pending, level_weight(cfg, 1));
+        row.pending = 0;
+        row.lastupdated = now;
+    });
+}//END settle_pending()
+
+// === Settle === //
+// --- Anyone can push a user's deferred invites up to their upline --- //
+
+void invitono::settle(name user) {
+  const contract_config& cfg = current_config();
+
+  const adopterv2* user_row = find_adopter(user);
+  check(user_row, "🎧 We can't find you in our records");
+  check(user_row->pending.value > 0, "🔇 Nothing to settle yet");
+
+  settle_pending(*user_row, cfg, current_time_point().sec_since_epoch());
+}//END settle()
+
 // === Claim Reward === //
 // --- Mints tokens based on invite score (1 TOKEN per point) --- //
 
@@ -107,48 +370,166 @@ void invitono::claimreward(name user) {
   check(has_auth(user) || has_auth(get_self()) || has_tonomy_auth(user), "🎵 Only you, the contract, or Tonomy ID can claim your rewards");
 
   // - Contract status check
-  config_table conf(get_self(), get_self().value);
-  auto cfg = conf.get_or_default();
+  const contract_config& cfg = current_config();
 
   // - User validation
-  adopters_table adopters(get_self(), get_self().value);
-  auto itr = adopters.find(user.value);
-  check(itr != adopters.end(), "🎧 We can't find you in our records");
+  const adopterv2* user_row = find_adopter(user);
+  check(user_row, "🎧 We can't find you in our records");
+
+  // - Credit deferred invites before scoring
+  uint32_t now = current_time_point().sec_since_epoch();
+  settle_pending(*user_row, cfg, now);
+  user_row = find_adopter(user);
+
+  // - Pool mode pays the accrued share and keeps the score earning
+  if (cfg.pool_mode) {
+    uint64_t owed = 0;
+    update_adopter(*user_row, [&](auto& row) {
+      owed = row.owed;
+      row.owed = 0;
+      row.flags |= adopterv2::FLAG_CLAIMED;
+    });
+    check(owed > 0, "🔇 You don't have any rewards to claim yet");
 
-  // - Score validation
-  uint32_t score = itr->score;
+    queue_payout(user, asset(static_cast<int64_t>(owed), cfg.reward_symbol), cfg, now);
+    return;
+  }
+
+  // - Score validation, decayed to now
+  uint32_t score = current_score(*user_row, cfg, now);
   check(score > 0, "🔇 You don't have any rewards to claim yet"); // Low volume for no rewards
 
-  // - Calculate base reward amount first (score * reward_rate / 100)
-  uint8_t precision = cfg.reward_symbol.precision();
-  int64_t base_amount = (static_cast<int64_t>(score) * static_cast<int64_t>(pow(10, precision)) * cfg.reward_rate) / 100;
-  
-  // - Calculate tetrahedral position for bonus percentage
-  uint32_t position = calculate_tetrahedral_position(score);
-  
-  // - Apply position-based bonus (each position adds 1% bonus)
-  int64_t bonus_percentage = position; // Position directly becomes the percentage bonus
-  int64_t bonus_amount = (base_amount * bonus_percentage) / 100;
-  
-  // - Total reward is base amount plus bonus
-  int64_t total_amount = base_amount + bonus_amount;
-  asset reward = asset(total_amount, cfg.reward_symbol);
+  // - Calculate curve position for bonus percentage (each position adds 1% bonus)
+  uint32_t position = calculate_curve_position(score, cfg);
+
+  // - Base, bonus and multiplier in one exact integer pass
+  asset reward = reward_for(score, position, cfg);
+  check(reward.amount > 0, "🔇 You don't have any rewards to claim yet");
 
   // - Mark as claimed and reset score
-  adopters.modify(itr, same_payer, [&](auto& row) {
-    row.claimed = true;
+  update_adopter(*user_row, [&](auto& row) {
+    row.flags |= adopterv2::FLAG_CLAIMED;
     row.score = 0;  // Reset score after claiming
   });
 
-  // - Transfer reward tokens
-  action(
-    permission_level{get_self(), "active"_n},
-    cfg.token_contract,
-    "transfer"_n,
-    std::make_tuple(get_self(), user, reward, std::string("🎵 Level " + std::to_string(position) + " reward! Thanks for making yourself heard on the Web4 Music Map! 🔺 Use your invite rewards to upvote on cXc.world."))
-  ).send();
+  // - Queue reward tokens for the payout crank
+  queue_payout(user, reward, cfg, now);
 }//END claimreward()
 
+// === Queue Payout === //
+// --- Claims only record what is owed; processq sends the transfers --- //
+
+void invitono::queue_payout(name recipient, asset quantity, const contract_config& cfg, uint32_t now) {
+  payouts_table payouts(get_self(), get_self().value);
+  payouts.emplace(get_self(), [&](auto& row) {
+    row.id = payouts.available_primary_key();
+    row.recipient = recipient;
+    row.token_contract = cfg.token_contract;
+    row.quantity = quantity;
+    row.queued_at = now;
+  });
+}//END queue_payout()
+
+// === Process Queue === //
+// --- Anyone can drain up to max_items payouts, one transfer per recipient and token --- //
+
+void invitono::processq(uint32_t max_items) {
+  check(max_items > 0 && max_items <= MAX_PAYOUT_ITEMS, "Invalid max_items (1-100)");
+
+  payouts_table payouts(get_self(), get_self().value);
+  check(payouts.begin() != payouts.end(), "🎵 No payouts waiting");
+
+  auto by_recipient = payouts.get_index<"byrecipient"_n>();
+  uint32_t items = 0;
+
+  // - Oldest payout picks the recipient, then all of their queued payouts in the same token join it
+  while (items < max_items && payouts.begin() != payouts.end()) {
+    const auto head = *payouts.begin();
+    asset total(0, head.quantity.symbol);
+
+    auto itr = by_recipient.lower_bound(head.recipient.value);
+    while (itr != by_recipient.end() && itr->recipient == head.recipient && items < max_items) {
+      if (itr->token_contract != head.token_contract || itr->quantity.symbol != head.quantity.symbol) {
+        ++itr;
+        continue;
+      }
+      total += itr->quantity;
+      itr = by_recipient.erase(itr);
+      items++;
+    }
+
+    action(
+      permission_level{get_self(), "active"_n},
+      head.token_contract,
+      "transfer"_n,
+      std::make_tuple(get_self(), head.recipient, total, std::string("🎵 Invite rewards! Thanks for making yourself heard on the Web4 Music Map! 🔺 Use your invite rewards to upvote on cXc.world."))
+    ).send();
+  }
+}//END processq()
+
+// === Park Payee === //
+// --- A transfer that always fails (closed account, broken token) would otherwise hold the queue head forever --- //
+
+void invitono::parkpayee(name recipient) {
+  config_table conf(get_self(), get_self().value);
+  admin_config(conf);
+
+  payouts_table payouts(get_self(), get_self().value);
+  parked_table parked(get_self(), get_self().value);
+  auto by_recipient = payouts.get_index<"byrecipient"_n>();
+
+  auto itr = by_recipient.lower_bound(recipient.value);
+  check(itr != by_recipient.end() && itr->recipient == recipient, "🎵 No payouts waiting for this recipient");
+
+  for (uint32_t items = 0; items < MAX_PAYOUT_ITEMS && itr != by_recipient.end() && itr->recipient == recipient; items++) {
+    parked.emplace(get_self(), [&](auto& row) {
+      row = *itr;
+    });
+    itr = by_recipient.erase(itr);
+  }
+}//END parkpayee()
+
+// === Requeue === //
+// --- Once the recipient can receive again, the payout goes behind everything queued since --- //
+
+void invitono::requeue(uint64_t id) {
+  config_table conf(get_self(), get_self().value);
+  admin_config(conf);
+
+  parked_table parked(get_self(), get_self().value);
+  auto& row = parked.get(id, "🎵 No parked payout with this id");
+
+  payouts_table payouts(get_self(), get_self().value);
+  payouts.emplace(get_self(), [&](auto& queued) {
+    queued = row;
+    queued.id = payouts.available_primary_key();
+  });
+  parked.erase(row);
+}//END requeue()
+
+// === Cancel Payout === //
+// --- The claim already reset the user's score, so a cancelled payout is settled off-chain if at all --- //
+
+void invitono::cancelpayout(uint64_t id) {
+  config_table conf(get_self(), get_self().value);
+  admin_config(conf);
+
+  parked_table parked(get_self(), get_self().value);
+  auto& row = parked.get(id, "🎵 No parked payout with this id");
+  parked.erase(row);
+}//END cancelpayout()
+
+// === Reward For === //
+// --- Shared by claimreward and previewclaim so estimates match payouts --- //
+
+asset invitono::reward_for(uint32_t score, uint32_t position, const contract_config& cfg) {
+  uint8_t precision = cfg.reward_symbol.precision();
+  check(precision <= rewards::MAX_PRECISION, "Invalid reward symbol precision");
+
+  int64_t amount = rewards::reward_amount(score, precision, cfg.reward_rate, position, cfg.multiplier);
+  return asset(amount, cfg.reward_symbol);
+}//END reward_for()
+
 // === Set Config === //
 // --- Admin sets contract-wide configuration --- //
 
@@ -167,11 +548,12 @@ void invitono::setconfig(
     config_table conf(get_self(), get_self().value);
 
     // - Parameter validation
-    check(max_depth > 0 && max_depth <= 10, "Invalid depth (1-10)");
+    check(max_depth > 0 && max_depth <= MAX_REFERRAL_DEPTH, "Invalid depth (1-64)");
     check(multiplier > 0 && multiplier <= 1000, "Invalid multiplier (1-1000)");
     check(is_account(admin), "New admin account does not exist");
     check(is_account(token_contract), "Token contract account does not exist");
     check(reward_symbol.is_valid(), "Invalid reward symbol");
+    check(reward_symbol.precision() <= rewards::MAX_PRECISION, "Invalid reward symbol precision");
     check(reward_rate > 0, "Reward rate must be positive");
 
     // - Handle first-time initialization
@@ -199,20 +581,787 @@ void invitono::setconfig(
     check(min_age_days > 0, "Minimum age must be positive");
     check(rate_seconds > 0, "Rate must be positive");
 
-    // - Update configuration
-    conf.set(config{
-        .min_account_age_days = min_age_days,
-        .invite_rate_seconds = rate_seconds,
-        .enabled = enabled,
-        .admin = admin,
-        .max_referral_depth = max_depth,
-        .multiplier = multiplier,
-        .token_contract = token_contract,
-        .reward_symbol = reward_symbol,
-        .reward_rate = reward_rate
-    }, get_self());
+    // - Rebuild level weights when the depth changes
+    settings_table sets(get_self(), get_self().value);
+    auto extra = sets.get_or_default();
+    if (max_depth != current.max_referral_depth && !extra.level_weights.empty()) {
+        extra.level_weights = build_weights(max_depth, extra.level_decay);
+        sets.set(extra, get_self());
+    }
+
+    // - Update configuration, keeping fields managed by other actions
+    current.min_account_age_days = min_age_days;
+    current.invite_rate_seconds = rate_seconds;
+    current.enabled = enabled;
+    current.admin = admin;
+    current.max_referral_depth = max_depth;
+    current.multiplier = multiplier;
+    current.token_contract = token_contract;
+    current.reward_symbol = reward_symbol;
+    current.reward_rate = reward_rate;
+    conf.set(current, get_self());
 }//END setconfig()
 
+// === Set Scoring === //
+// --- Admin selects eager or lazy upline crediting --- //
+
+void invitono::setscoring(bool lazy_scores) {
+    settings_table sets(get_self(), get_self().value);
+    auto current = admin_settings(sets);
+
+    current.lazy_scores = lazy_scores;
+    sets.set(current, get_self());
+}//END setscoring()
+
+// === Set Decay === //
+// --- Admin sets per-level weight decay; weights are built here, not per invite --- //
+
+void invitono::setdecay(uint8_t level_decay) {
+    settings_table sets(get_self(), get_self().value);
+    auto current = admin_settings(sets);
+
+    check(level_decay > 0 && level_decay <= 100, "Invalid decay (1-100)");
+
+    current.level_decay = level_decay;
+    current.level_weights = build_weights(current_config().max_referral_depth, level_decay);
+    sets.set(current, get_self());
+}//END setdecay()
+
+// === Set Half-Life === //
+// --- Admin sets score decay; rows catch up on their next touch --- //
+
+void invitono::sethalflife(uint32_t half_life) {
+    settings_table sets(get_self(), get_self().value);
+    auto current = admin_settings(sets);
+
+    // - Rows decay in whole 1/64 half-life steps
+    check(half_life % decay::STEPS == 0, "Half-life must be a multiple of 64 seconds");
+
+    current.half_life = half_life;
+    sets.set(current, get_self());
+}//END sethalflife()
+
+// === Set Tonomy === //
+// --- Admin looks up the app in Tonomy's apps table once instead of on every action --- //
+
+void invitono::settonomy(string app_username) {
+    settings_table sets(get_self(), get_self().value);
+    auto current = admin_settings(sets);
+
+    // - An empty username turns Tonomy ID authorization off
+    if (app_username.empty()) {
+        current.tonomy_app = name{};
+        sets.set(current, get_self());
+        return;
+    }
+
+    tonomysystem::tonomy::apps_table apps(TONOMY_CONTRACT, TONOMY_CONTRACT.value);
+    auto apps_by_username = apps.get_index<"usernamehash"_n>();
+
+    checksum256 username_hash = sha256(app_username.c_str(), app_username.size());
+    auto app = apps_by_username.find(username_hash);
+    check(app != apps_by_username.end(), "No Tonomy app with this username found");
+
+    current.tonomy_app = app->account_name;
+    sets.set(current, get_self());
+}//END settonomy()
+
+// === Set Pool Mode === //
+// --- Admin picks per-point rewards or pro-rata pool shares for claims --- //
+
+void invitono::setpoolmode(bool pool_mode) {
+    settings_table sets(get_self(), get_self().value);
+    auto current = admin_settings(sets);
+    if (current.pool_mode == pool_mode) return;
+
+    // - The score total is kept in both modes, so a switch touches nothing else
+    current.pool_mode = pool_mode;
+    sets.set(current, get_self());
+}//END setpoolmode()
+
+// === Fund Pool === //
+// --- One accumulator bump shares the budget across every current score --- //
+
+void invitono::fundpool(asset amount) {
+    config_table conf(get_self(), get_self().value);
+    auto current = admin_config(conf);
+
+    check(amount.symbol == current.reward_symbol, "Pool funds must be in the reward symbol");
+    check(amount.amount > 0, "Pool funds must be positive");
+    check(current_config().pool_mode, "🔇 Switch pool mode on before funding the pool");
+
+    // - Legacy scores join the total as they migrate, so every stored score shares the budget only once migration is done
+    check(_legacy.begin() == _legacy.end(), "🎵 Fund the pool once migrate completes");
+    uint64_t total = score_total();
+    check(total > 0, "🔇 No scores to share the pool yet");
+
+    // - The contract pays claims from its own balance, so the budget must be transferred to it separately
+    auto& totals = current_pool();
+    totals.reward_per_score += (static_cast<uint128_t>(amount.amount) << 64) / total;
+    totals.funded += amount.amount;
+    _pool_dirty = true;
+}//END fundpool()
+
+// === Build Weights === //
+// --- Level 1 is a full point, each level down keeps decay percent of the one above --- //
+
+std::vector<uint16_t> invitono::build_weights(uint16_t depth, uint8_t decay) {
+    // - Flat weights need no table
+    if (decay == 100) return {};
+
+    std::vector<uint16_t> weights(depth);
+    uint32_t weight = WEIGHT_ONE;
+    for (auto& level : weights) {
+        level = weight;
+        weight = weight * decay / 100;
+    }
+    return weights;
+}//END build_weights()
+
+// === Set Limiter === //
+// --- Admin sizes the invite bucket and its refill interval --- //
+
+void invitono::setlimiter(uint16_t burst, uint32_t refill_seconds) {
+    config_table conf(get_self(), get_self().value);
+    settings_table sets(get_self(), get_self().value);
+    auto current = admin_config(conf);
+    auto extra = admin_settings(sets);
+
+    check(burst > 0, "Burst must be positive");
+    check(refill_seconds > 0, "Refill must be positive");
+
+    extra.invite_burst = burst;
+    current.invite_rate_seconds = refill_seconds;
+    conf.set(current, get_self());
+    sets.set(extra, get_self());
+}//END setlimiter()
+
+// === Set Curve === //
+// --- Admin selects the bonus curve without a new WASM build --- //
+
+void invitono::setcurve(uint8_t curve, uint32_t step) {
+    settings_table sets(get_self(), get_self().value);
+    auto current = admin_settings(sets);
+
+    check(curve <= curves::CAPPED_LINEAR, "Invalid curve (0-3)");
+    check(curve != curves::CAPPED_LINEAR || step > 0, "Linear step must be positive");
+
+    current.reward_curve = curve;
+    current.curve_step = step;
+    sets.set(current, get_self());
+}//END setcurve()
+
+// === Set Board === //
+// --- Admin sizes the leaderboard and switches byscore index upkeep --- //
+
+void invitono::setboard(uint16_t size, bool index_scores) {
+    settings_table sets(get_self(), get_self().value);
+    auto current = admin_settings(sets);
+
+    check(size <= MAX_LEADERBOARD, "Invalid leaderboard size (0-100)");
+
+    current.leaderboard_size = size;
+    current.index_scores = index_scores;
+    sets.set(current, get_self());
+    _config.reset();
+
+    // - Shrink the stored board to the new size, or fill free places from the index so an existing deployment starts with a full board
+    auto& board = current_board();
+    if (board.leaders.size() > size) {
+        board.leaders.resize(size);
+        _board_dirty = true;
+    } else if (index_scores) {
+        fill_board(current_config());
+    }
+}//END setboard()
+
+// === Track Leader === //
+// --- Keeps the top leaderboard_size stored scores sorted, highest first --- //
+
+void invitono::track_leader(const adopterv2& row, const contract_config& cfg) {
+    if (cfg.leaderboard_size == 0) return;
+
+    auto& leaders = current_board().leaders;
+    uint32_t score = row.score.value;
+
+    // - Drop the old entry unless the score is unchanged
+    auto existing = std::find_if(leaders.begin(), leaders.end(), [&](const leader& entry) {
+        return entry.account == row.account;
+    });
+    if (existing != leaders.end()) {
+        if (existing->score == score) return;
+        bool dropped = score < existing->score;
+        leaders.erase(existing);
+        _board_dirty = true;
+
+        // - A lower score can fall behind rows off the board; the index finds the best of them, this row included
+        if (dropped && cfg.index_scores) {
+            refill_board(cfg, score == 0 ? row.account : name{});
+            return;
+        }
+    }
+
+    // - Insert when there's room or it beats the lowest entry
+    if (score == 0) return;
+    if (leaders.size() >= cfg.leaderboard_size && score <= leaders.back().score) return;
+
+    auto position = std::upper_bound(leaders.begin(), leaders.end(), score, [](uint32_t value, const leader& entry) {
+        return value > entry.score;
+    });
+    leaders.insert(position, leader{row.account, score});
+    if (leaders.size() > cfg.leaderboard_size) leaders.pop_back();
+    _board_dirty = true;
+}//END track_leader()
+
+// === Refill Board === //
+// --- Adds the highest indexed score not on the board, taking the head of each scope's byscore index --- //
+
+void invitono::refill_board(const contract_config& cfg, name skip) {
+    auto& leaders = current_board().leaders;
+    if (leaders.size() >= cfg.leaderboard_size) return;
+
+    std::optional<leader> best;
+    for (uint64_t index = 0; index < scope_count(); index++) {
+        auto by_score = adopters_at(index).get_index<"byscore"_n>();
+        for (auto itr = by_score.begin(); itr != by_score.end(); ++itr) {
+            // - Unindexed rows sort last with stale keys, and empty scores never lead
+            if ((itr->flags & adopterv2::FLAG_UNINDEXED) || itr->score.value == 0) break;
+            if (best && itr->score.value <= best->score) break;
+
+            // - skip is a row being removed whose index entry still holds its old score
+            bool listed = itr->account == skip || std::any_of(leaders.begin(), leaders.end(), [&](const leader& entry) {
+                return entry.account == itr->account;
+            });
+            if (listed) continue;
+
+            best = leader{itr->account, itr->score.value};
+            break;
+        }
+    }
+    if (!best) return;
+
+    auto position = std::upper_bound(leaders.begin(), leaders.end(), best->score, [](uint32_t value, const leader& entry) {
+        return value > entry.score;
+    });
+    leaders.insert(position, *best);
+    _board_dirty = true;
+}//END refill_board()
+
+// === Fill Board === //
+// --- Tops the board up to leaderboard_size from the head of each scope's byscore index --- //
+
+void invitono::fill_board(const contract_config& cfg) {
+    auto& leaders = current_board().leaders;
+    if (leaders.size() >= cfg.leaderboard_size) return;
+
+    // - No scope supplies more than leaderboard_size unlisted rows, so each index is read only that far
+    std::vector<leader> candidates = leaders;
+    for (uint64_t index = 0; index < scope_count(); index++) {
+        auto by_score = adopters_at(index).get_index<"byscore"_n>();
+        uint32_t taken = 0;
+        for (auto itr = by_score.begin(); itr != by_score.end() && taken < cfg.leaderboard_size; ++itr) {
+            // - Unindexed rows sort last with stale keys, and empty scores never lead
+            if ((itr->flags & adopterv2::FLAG_UNINDEXED) || itr->score.value == 0) break;
+
+            bool listed = std::any_of(leaders.begin(), leaders.end(), [&](const leader& entry) {
+                return entry.account == itr->account;
+            });
+            if (listed) continue;
+
+            candidates.push_back(leader{itr->account, itr->score.value});
+            taken++;
+        }
+    }
+    if (candidates.size() == leaders.size()) return;
+
+    // - Listed entries keep their place among equal scores; archived ones stay listed until outscored
+    std::stable_sort(candidates.begin(), candidates.end(), [](const leader& a, const leader& b) {
+        return a.score > b.score;
+    });
+    if (candidates.size() > cfg.leaderboard_size) candidates.resize(cfg.leaderboard_size);
+    leaders = std::move(candidates);
+    _board_dirty = true;
+}//END fill_board()
+
+// === Set Shards === //
+// --- Admin sets how many rows registrations spread their stats over --- //
+
+void invitono::setshards(uint16_t shards) {
+    settings_table sets(get_self(), get_self().value);
+    auto current = admin_settings(sets);
+
+    // - Aggregates read every shard row, so the count can change at any time
+    check(shards <= MAX_STATS_SHARDS, "Invalid shard count (0-64)");
+
+    current.stats_shards = shards;
+    sets.set(current, get_self());
+}//END setshards()
+
+// === Set Scopes === //
+// --- Admin spreads adopter rows over hash-bucket scopes --- //
+
+void invitono::setscopes(uint16_t scopes) {
+    settings_table sets(get_self(), get_self().value);
+    auto current = admin_settings(sets);
+
+    check(scopes <= MAX_ADOPTER_SCOPES, "Invalid scope count (0-64)");
+
+    // - Lookups derive the scope from the name, so existing rows would be lost
+    check(_legacy.begin() == _legacy.end(), "Adopters already exist");
+    check(adopters_in(get_self().value).begin() == adopters_in(get_self().value).end(), "Adopters already exist");
+    for (uint16_t bucket = 0; bucket < current.adopter_scopes; bucket++) {
+        check(adopters_in(bucket).begin() == adopters_in(bucket).end(), "Adopters already exist");
+    }
+
+    current.adopter_scopes = scopes;
+    sets.set(current, get_self());
+}//END setscopes()
+
+// === Add Stats === //
+// --- Writes each registering user's shard once, whatever the batch size --- //
+
+void invitono::add_stats(const std::vector<name>& users, uint32_t now) {
+    const contract_config& cfg = current_config();
+
+    // - Single singleton when sharding is off
+    if (cfg.stats_shards == 0) {
+        stats_table stats(get_self(), get_self().value);
+        auto current = stats.get_or_default();
+        current.total_users += users.size();
+        current.total_referrals += users.size();
+        current.last_registered = users.back();
+        stats.set(current, get_self());
+        return;
+    }
+
+    // - Count per shard first; the last user hashed to a shard is its latest registration
+    std::map<uint64_t, std::pair<uint64_t, name>> counts;
+    for (const auto& user : users) {
+        auto& [count, last] = counts[name_bucket(user, cfg.stats_shards)];
+        count += 1;
+        last = user;
+    }
+
+    statshards_table shards(get_self(), get_self().value);
+    for (const auto& [shard, counted] : counts) {
+        auto itr = shards.find(shard);
+        // - The action's score change shares the write of its shard
+        bool scored = _score_delta != 0 && shard == score_shard(_score_account);
+        auto update = [&](auto& row) {
+            row.id = shard;
+            row.total_users += counted.first;
+            row.total_referrals += counted.first;
+            row.last_registered = counted.second;
+            row.last_registered_at = now;
+            if (scored) row.total_score += _score_delta;
+        };
+        if (itr == shards.end()) {
+            shards.emplace(get_self(), update);
+        } else {
+            shards.modify(itr, same_payer, update);
+        }
+        if (scored) _score_delta = 0;
+    }
+}//END add_stats()
+
+// === Flush Score === //
+// --- Adds the action's net score change to the shard of the first account it changed --- //
+
+void invitono::flush_score() {
+    uint64_t shard = score_shard(_score_account);
+    statshards_table shards(get_self(), get_self().value);
+    auto itr = shards.find(shard);
+    auto update = [&](auto& row) {
+        row.id = shard;
+        row.total_score += _score_delta;
+    };
+    if (itr == shards.end()) {
+        shards.emplace(get_self(), update);
+    } else {
+        shards.modify(itr, same_payer, update);
+    }
+    _score_delta = 0;
+}//END flush_score()
+
+// === Score Total === //
+// --- Sum of stored adopter scores, as the shards' net changes add up to it --- //
+
+uint64_t invitono::score_total() {
+    int64_t total = _score_delta;
+    statshards_table shards(get_self(), get_self().value);
+    for (const auto& shard : shards) total += shard.total_score;
+    return total > 0 ? static_cast<uint64_t>(total) : 0;
+}//END score_total()
+
+// === Remove Stats === //
+// --- Counts removals in their own row, so they never depend on which shard counted the registration --- //
+
+void invitono::remove_stats() {
+    statshards_table shards(get_self(), get_self().value);
+    auto itr = shards.find(REMOVED_SHARD);
+    auto uncount = [&](auto& row) {
+        row.id = REMOVED_SHARD;
+        row.total_users += 1;
+        row.total_referrals += 1;
+    };
+    if (itr == shards.end()) {
+        shards.emplace(get_self(), uncount);
+    } else {
+        shards.modify(itr, same_payer, uncount);
+    }
+}//END remove_stats()
+
+// === Aggregate Stats === //
+// --- Stats singleton plus every shard, less removals; latest registration wins --- //
+
+invitono::stats invitono::aggregate_stats() {
+    stats_table stats(get_self(), get_self().value);
+    auto total = stats.get_or_default();
+
+    uint32_t latest = 0;
+    uint64_t removed_users = 0;
+    uint64_t removed_referrals = 0;
+    statshards_table shards(get_self(), get_self().value);
+    for (const auto& shard : shards) {
+        if (shard.id == REMOVED_SHARD) {
+            removed_users = shard.total_users;
+            removed_referrals = shard.total_referrals;
+            continue;
+        }
+        total.total_users += shard.total_users;
+        total.total_referrals += shard.total_referrals;
+        if (shard.last_registered_at >= latest && shard.last_registered != name{}) {
+            latest = shard.last_registered_at;
+            total.last_registered = shard.last_registered;
+        }
+    }
+
+    // - Every removed user was counted once when registering
+    total.total_users -= removed_users;
+    total.total_referrals -= removed_referrals;
+    return total;
+}//END aggregate_stats()
+
+// === Current Config === //
+// --- Reads the config and settings singletons once per action --- //
+
+const invitono::contract_config& invitono::current_config() {
+    if (!_config) {
+        config_table conf(get_self(), get_self().value);
+        settings_table sets(get_self(), get_self().value);
+        _config.emplace();
+        static_cast<config&>(*_config) = conf.get_or_default();
+        static_cast<settings&>(*_config) = sets.get_or_default();
+    }
+    return *_config;
+}//END current_config()
+
+// === Current Pool === //
+// --- Reads the pool singleton once per action --- //
+
+invitono::pool& invitono::current_pool() {
+    if (!_pool) {
+        pool_table pools(get_self(), get_self().value);
+        _pool = pools.get_or_default();
+    }
+    return *_pool;
+}//END current_pool()
+
+// === Track Score === //
+// --- Collects stored score changes for one shard write per action; the first changed account picks the shard --- //
+
+void invitono::track_score(name account, int64_t delta) {
+    if (delta == 0) return;
+
+    if (_score_delta == 0) _score_account = account;
+    _score_delta += delta;
+}//END track_score()
+
+// === Score Shard === //
+// --- The account's stats shard, or shard 0 when sharding is off --- //
+
+uint64_t invitono::score_shard(name account) {
+    const contract_config& cfg = current_config();
+    return cfg.stats_shards == 0 ? 0 : name_bucket(account, cfg.stats_shards);
+}//END score_shard()
+
+// === Pool Owed === //
+// --- Accrues a copy against the current reward per score --- //
+
+uint64_t invitono::pool_owed(const adopterv2& row) {
+    adopterv2 accrued = row;
+    accrued.accrue(current_pool().reward_per_score);
+    return accrued.owed;
+}//END pool_owed()
+
+// === Current Board === //
+// --- Reads the leaderboard singleton once per action --- //
+
+invitono::leaderboard& invitono::current_board() {
+    if (!_board) {
+        leaderboard_table board(get_self(), get_self().value);
+        _board = board.get_or_default();
+    }
+    return *_board;
+}//END current_board()
+
+// === Admin Config === //
+// --- Loads the config and requires the admin's authorization --- //
+
+invitono::config invitono::admin_config(config_table& conf) {
+    check(conf.exists(), "Config not initialized");
+
+    auto current = conf.get();
+    require_auth(current.admin);
+    return current;
+}//END admin_config()
+
+// === Admin Settings === //
+// --- Loads the settings (defaults until first set) and requires the admin's authorization --- //
+
+invitono::settings invitono::admin_settings(settings_table& sets) {
+    config_table conf(get_self(), get_self().value);
+    admin_config(conf);
+
+    return sets.get_or_default();
+}//END admin_settings()
+
+// === Get Stats === //
+// --- Read-only global statistics --- //
+
+invitono::stats invitono::getstats() {
+  return aggregate_stats();
+}//END getstats()
+
+// === Get Ancestor === //
+// --- Read-only k-th ancestor of a user --- //
+
+name invitono::getancestor(name user, uint16_t k) {
+  check(find_adopter(user), "🎧 We can't find you in our records");
+
+  return kth_ancestor(user, k);
+}//END getancestor()
+
+// === Get LCA === //
+// --- Read-only lowest common ancestor of two users --- //
+
+name invitono::getlca(name a, name b) {
+  check(find_adopter(a) && find_adopter(b), "🎧 We can't find both users in our records");
+
+  return lowest_common_ancestor(a, b);
+}//END getlca()
+
+// === Get Upline === //
+// --- Read-only credited ancestors with their scores in one call --- //
+
+std::vector<invitono::upline_entry> invitono::getupline(name user) {
+  const contract_config& cfg = current_config();
+  uint32_t now = current_time_point().sec_since_epoch();
+
+  const adopterv2* user_row = find_adopter(user);
+  check(user_row, "🎧 We can't find you in our records");
+
+  std::vector<upline_entry> entries;
+  uint16_t level = 0;
+  for (const auto& ancestor : collect_upline(user_row->upline, cfg.max_referral_depth)) {
+    level++;
+    const adopterv2* ancestor_row = find_adopter(ancestor);
+    if (!ancestor_row) continue;
+    entries.push_back(upline_entry{ancestor, level, current_score(*ancestor_row, cfg, now)});
+  }
+  return entries;
+}//END getupline()
+
+// === Preview Claim === //
+// --- Read-only claimreward result without settling or transferring --- //
+
+invitono::claim_preview invitono::previewclaim(name user) {
+  const contract_config& cfg = current_config();
+
+  const adopterv2* user_row = find_adopter(user);
+  check(user_row, "🎧 We can't find you in our records");
+
+  // - A claim decays the score to now, then settles pending invites onto it
+  claim_preview preview;
+  preview.pending = user_row->pending.value;
+  uint64_t settled = user_row->fraction + static_cast<uint64_t>(level_weight(cfg, 1)) * preview.pending;
+  preview.score = current_score(*user_row, cfg, current_time_point().sec_since_epoch()) + static_cast<uint32_t>(settled >> 8);
+  preview.position = calculate_curve_position(preview.score, cfg);
+
+  // - Pool mode pays what the stored score has accrued since its checkpoint
+  if (cfg.pool_mode) {
+    preview.reward = asset(static_cast<int64_t>(pool_owed(*user_row)), cfg.reward_symbol);
+    return preview;
+  }
+
+  preview.reward = reward_for(preview.score, preview.position, cfg);
+  return preview;
+}//END previewclaim()
+
+// === Get Downline === //
+// --- Read-only page of direct invitees from the byinviter index of every scope and the archive --- //
+
+invitono::downline_page invitono::getdownline(name user, name lower_bound, uint16_t limit) {
+  check(limit > 0 && limit <= MAX_DOWNLINE_PAGE, "Invalid limit (1-100)");
+  check(user == get_self() || find_adopter(user), "🎧 We can't find you in our records");
+
+  // - Legacy rows carry no byinviter entry
+  check(_legacy.begin() == _legacy.end(), "🎵 Downlines are listed once migrate completes");
+
+  // - One extra invitee tells whether another page follows
+  std::vector<name> invitees = collect_invitees(user, lower_bound, limit + 1);
+
+  downline_page page;
+  if (invitees.size() > limit) {
+    page.next = invitees[limit];
+    invitees.resize(limit);
+  }
+  page.invitees = std::move(invitees);
+  return page;
+}//END getdownline()
+
+// === Collect Invitees === //
+// --- Invitees hash to any scope or sit in the archive, so take up to count from each and merge --- //
+
+std::vector<name> invitono::collect_invitees(name user, name lower_bound, uint32_t count) {
+  std::vector<name> invitees;
+  for (uint64_t index = 0; index < scope_count(); index++) {
+    auto by_inviter = adopters_at(index).get_index<"byinviter"_n>();
+
+    uint32_t taken = 0;
+    auto itr = by_inviter.lower_bound((static_cast<uint128_t>(user.value) << 64) | lower_bound.value);
+    for (; itr != by_inviter.end() && itr->invitedby == user && taken < count; ++itr, ++taken) {
+      invitees.push_back(itr->account);
+    }
+  }
+
+  // - Archived invitees have an inviter index of their own
+  auto cold_by_inviter = _cold.get_index<"byinviter"_n>();
+  auto cold = cold_by_inviter.lower_bound((static_cast<uint128_t>(user.value) << 64) | lower_bound.value);
+  for (uint32_t taken = 0; cold != cold_by_inviter.end() && cold->invitedby == user && taken < count; ++cold, ++taken) {
+    invitees.push_back(cold->account);
+  }
+
+  std::sort(invitees.begin(), invitees.end());
+  if (invitees.size() > count) invitees.resize(count);
+  return invitees;
+}//END collect_invitees()
+
+// === Migrate === //
+// --- Moves legacy rows into the packed table top-down, max_rows steps per call --- //
+
+void invitono::migrate(uint32_t max_rows) {
+  config_table conf(get_self(), get_self().value);
+  check(has_auth(get_self()) || (conf.exists() && has_auth(conf.get().admin)), "Only the contract or admin can migrate");
+  check(max_rows > 0, "max_rows must be positive");
+
+  migcursor_table cursors(get_self(), get_self().value);
+  auto cursor = cursors.get_or_default();
+  check(!cursor.waiting.empty() || _legacy.begin() != _legacy.end(), "🎵 Nothing left to migrate");
+
+  // - Each step walks up to one more unmigrated inviter or writes the deepest waiting row whose inviter is packed,
+  // - so a chain of any depth migrates over as many calls as it needs
+  for (uint32_t step = 0; step < max_rows; step++) {
+    if (cursor.waiting.empty()) {
+      auto next = _legacy.begin();
+      if (next == _legacy.end()) break;
+      cursor.waiting.push_back(next->account);
+    }
+
+    // - Rows written by other actions since have migrated on write
+    name account = cursor.waiting.back();
+    auto legacy = _legacy.find(account.value);
+    if (legacy == _legacy.end()) {
+      cursor.waiting.pop_back();
+      continue;
+    }
+
+    // - An inviter still in the legacy table goes first; one already waiting is a cycle, so the row becomes a root
+    name inviter = legacy->invitedby;
+    bool root = inviter == get_self() || inviter == name{} || inviter == account;
+    bool cycle = !root && std::find(cursor.waiting.begin(), cursor.waiting.end(), inviter) != cursor.waiting.end();
+    if (!root && !cycle && _legacy.find(inviter.value) != _legacy.end()) {
+      cursor.waiting.push_back(inviter);
+      continue;
+    }
+
+    adopterv2 row = pack_adopter(*legacy);
+    link_upline(row, root || cycle ? nullptr : find_adopter(inviter));
+    adopters_for(account).emplace(get_self(), [&](auto& packed) {
+      packed = row;
+    });
+    track_score(account, row.score.value);
+    _converted.erase(account.value);
+    _legacy.erase(legacy);
+    cursor.waiting.pop_back();
+  }
+
+  cursors.set(cursor, get_self());
+}//END migrate()
+
+// === Set Root === //
+// --- Admin commits the whole off-chain referral graph in one transaction --- //
+
+void invitono::setroot(checksum256 root) {
+  settings_table sets(get_self(), get_self().value);
+  auto current = admin_settings(sets);
+
+  current.onboard_root = root;
+  sets.set(current, get_self());
+}//END setroot()
+
+// === Materialize === //
+// --- Anyone can create proven rows at their own RAM cost, each inviter before its invitees --- //
+
+void invitono::materialize(name payer, std::vector<onboard_leaf> chain) {
+  // - Whoever materializes pays the rows, so the contract's RAM can't be spent by anyone
+  require_auth(payer);
+  check(!chain.empty(), "🎼 No leaves to materialize");
+
+  const contract_config& cfg = current_config();
+  check(cfg.onboard_root != checksum256{}, "🎵 No onboarding root committed yet");
+
+  uint32_t now = current_time_point().sec_since_epoch();
+  std::vector<name> added;
+
+  for (const auto& leaf : chain) {
+    // - Another transaction may have materialized part of the chain already
+    if (find_adopter(leaf.user)) continue;
+
+    check(merkle_root(leaf) == cfg.onboard_root, "🎷 Invalid onboarding proof for " + leaf.user.to_string());
+    check(leaf.user != leaf.inviter, "🎹 You can't invite yourself");
+    check(is_account(leaf.user), "🎸 Account " + leaf.user.to_string() + " doesn't exist");
+
+    const adopterv2* inviter_row = leaf.inviter == get_self() ? nullptr : find_adopter(leaf.inviter);
+    check(inviter_row || leaf.inviter == get_self(), "🎷 Materialize " + leaf.inviter.to_string() + " first");
+
+    // - Imported scores already include the off-chain downline, so no upline credits
+    add_adopter(leaf.user, leaf.inviter, inviter_row, now, payer, leaf.score, adopterv2::FLAG_IMPORTED);
+    added.push_back(leaf.user);
+  }
+
+  if (!added.empty()) add_stats(added, now);
+}//END materialize()
+
+// === Merkle Root === //
+// --- sha256 of the packed leaf, then of each sorted pair up the proof --- //
+
+checksum256 invitono::merkle_root(const onboard_leaf& leaf) {
+  std::vector<char> packed = pack(std::make_tuple(leaf.user, leaf.inviter, leaf.score));
+  checksum256 node = sha256(packed.data(), packed.size());
+
+  for (const auto& sibling : leaf.proof) {
+    auto left = std::min(node, sibling).extract_as_byte_array();
+    auto right = std::max(node, sibling).extract_as_byte_array();
+
+    std::array<uint8_t, 64> pair;
+    std::copy(left.begin(), left.end(), pair.begin());
+    std::copy(right.begin(), right.end(), pair.begin() + 32);
+    node = sha256(reinterpret_cast<const char*>(pair.data()), pair.size());
+  }
+  return node;
+}//END merkle_root()
+
 // === Delete User === //
 // --- Development utility to remove a user --- //
 
@@ -220,12 +1369,267 @@ void invitono::deleteuser(name user) {
   // - Authorization check
   require_auth(get_self());
 
-  // - Remove user record
-  adopters_table adopters(get_self(), get_self().value);
+  // - Remove user record from any table
+  auto& adopters = adopters_for(user);
   auto itr = adopters.find(user.value);
+  auto legacy = _legacy.find(user.value);
+  auto cold = _cold.find(user.value);
+  check(itr != adopters.end() || legacy != _legacy.end() || cold != _cold.end(), "🎵 User not found in our records");
+
+  if (cold != _cold.end()) {
+    release_adopter(unpack<adopterv2>(cold->data), collect_invitees(user, name{}, UINT32_MAX));
+    _cold.erase(cold);
+  }
+
   if (itr != adopters.end()) {
+    release_adopter(*itr, collect_invitees(user, name{}, UINT32_MAX));
     adopters.erase(itr);
-  } else {
-    check(false, "🎵 User not found in our records");
   }
-}//END deleteuser()
\ No newline at end of file
+  if (legacy != _legacy.end()) _legacy.erase(legacy);
+}//END deleteuser()
+
+// === Prune === //
+// --- Walks every scope by cursor, compacting claimed and inactive rows into the archive in bounded chunks --- //
+
+void invitono::prune(uint32_t max_rows, uint32_t inactive_days) {
+  config_table conf(get_self(), get_self().value);
+  check(has_auth(get_self()) || (conf.exists() && has_auth(conf.get().admin)), "Only the contract or admin can prune");
+  check(max_rows > 0 && max_rows <= MAX_PRUNE_ROWS, "Invalid max_rows (1-100)");
+
+  const contract_config& cfg = current_config();
+  uint32_t now = current_time_point().sec_since_epoch();
+  uint64_t inactive_seconds = static_cast<uint64_t>(inactive_days) * 86400;
+  check(inactive_days > 0 && inactive_seconds <= now, "Invalid inactive_days");
+  uint32_t cutoff = now - inactive_seconds;
+
+  prunecursor_table cursors(get_self(), get_self().value);
+  auto cursor = cursors.get_or_default();
+
+  // - Each row examined costs one unit; archived rows are walked too
+  walk_adopters(cursor, max_rows, true, [&](const adopterv2& row, auto&& erase, uint32_t& budget) {
+    // - Only claimed, idle rows with nothing left to pay or settle
+    if (!row.claimed() || row.lastupdated > cutoff) return;
+    if (row.flags & adopterv2::FLAG_COMPACT) return;
+    if (row.pending.value > 0) return;
+
+    // - A score still earns rewards or pool shares; a copy is accrued since owed lags until the next write
+    if (row.score.value > 0 && current_score(row, cfg, now) > 0) return;
+    if (pool_owed(row) > 0) return;
+
+    // - The name stays registered and in its descendants' paths, so only the place in the tree is kept
+    adopterv2 compact;
+    compact.account = row.account;
+    compact.invitedby = row.invitedby;
+    compact.depth = row.depth;
+    compact.upline = row.upline;
+    compact.jumps = row.jumps;
+    compact.flags = row.flags | adopterv2::FLAG_COMPACT;
+    int64_t released = row.score.value;
+
+    // - Archived rows shrink in place; hot rows leave the byscore index for the archive
+    auto cold = _cold.find(row.account.value);
+    if (cold != _cold.end()) {
+      _cold.modify(cold, same_payer, [&](auto& archived) {
+        archived.data = pack(compact);
+      });
+    } else {
+      erase();
+      _cold.emplace(get_self(), [&](auto& archived) {
+        archived.account = compact.account;
+        archived.invitedby = compact.invitedby;
+        archived.data = pack(compact);
+      });
+    }
+
+    // - The decayed score leaves the pool total and the leaderboard; erase() may have released row
+    track_score(compact.account, -released);
+    track_leader(compact, cfg);
+    _converted.erase(compact.account.value);
+  });
+
+  cursors.set(cursor, get_self());
+}//END prune()
+
+// === Archive === //
+// --- Contract or admin moves idle rows out of the indexed table in bounded chunks --- //
+
+void invitono::archive(uint32_t max_rows, uint32_t inactive_days) {
+  // - Archived rows are billed to the contract, so only the contract or admin decides what moves
+  config_table conf(get_self(), get_self().value);
+  check(has_auth(get_self()) || (conf.exists() && has_auth(conf.get().admin)), "Only the contract or admin can archive");
+  check(max_rows > 0 && max_rows <= MAX_ARCHIVE_ROWS, "Invalid max_rows (1-100)");
+
+  uint32_t now = current_time_point().sec_since_epoch();
+  uint64_t inactive_seconds = static_cast<uint64_t>(inactive_days) * 86400;
+  check(inactive_days > 0 && inactive_seconds <= now, "Invalid inactive_days");
+  uint32_t cutoff = now - inactive_seconds;
+
+  archivecursor_table cursors(get_self(), get_self().value);
+  auto cursor = cursors.get_or_default();
+
+  walk_adopters(cursor, max_rows, false, [&](const adopterv2& row, auto&& erase, uint32_t& budget) {
+    // - Pending invites stay hot so settle finds them without a cold read
+    if (row.lastupdated > cutoff || row.pending.value > 0) return;
+
+    // - Whole row in one blob; its score stays in the pool total and leaderboard
+    _cold.emplace(get_self(), [&](auto& cold) {
+      cold.account = row.account;
+      cold.invitedby = row.invitedby;
+      cold.data = pack(row);
+    });
+    erase();
+  });
+
+  cursors.set(cursor, get_self());
+}//END archive()
+
+// === Release Adopter === //
+// --- Re-points direct invitees to the row's inviter and drops it from totals and the leaderboard --- //
+
+void invitono::release_adopter(const adopterv2& row, const std::vector<name>& invitees) {
+  for (const auto& invitee : invitees) {
+    // - Archived invitees are re-pointed in place so they stay cold
+    auto cold = _cold.find(invitee.value);
+    if (cold != _cold.end()) {
+      adopterv2 child = unpack<adopterv2>(cold->data);
+      child.invitedby = row.invitedby;
+      _cold.modify(cold, same_payer, [&](auto& archived) {
+        archived.invitedby = child.invitedby;
+        archived.data = pack(child);
+      });
+      _converted.erase(invitee.value);
+      continue;
+    }
+
+    const adopterv2* invitee_row = find_adopter(invitee);
+    if (!invitee_row) continue;
+
+    update_adopter(*invitee_row, [&](auto& child) {
+      child.invitedby = row.invitedby;
+    });
+  }
+
+  const contract_config& cfg = current_config();
+  track_score(row.account, -static_cast<int64_t>(row.score.value));
+  remove_stats();
+
+  adopterv2 removed = row;
+  removed.score = 0;
+  track_leader(removed, cfg);
+
+  // - Reads earlier in the action may have unpacked the row
+  _converted.erase(row.account.value);
+}//END release_adopter()
+
+// === Adopters For === //
+// --- Scope is a hash bucket of the account, or the contract when partitioning is off --- //
+
+invitono::adoptersv2_table& invitono::adopters_for(name account) {
+  const contract_config& cfg = current_config();
+  if (cfg.adopter_scopes == 0) return adopters_in(get_self().value);
+  return adopters_in(name_bucket(account, cfg.adopter_scopes));
+}//END adopters_for()
+
+// === Scope Count === //
+// --- Scopes holding adopter rows under the current config --- //
+
+uint64_t invitono::scope_count() {
+  const contract_config& cfg = current_config();
+  return cfg.adopter_scopes == 0 ? 1 : cfg.adopter_scopes;
+}//END scope_count()
+
+// === Adopters At === //
+// --- index-th scope in walk order: the contract scope, or bucket index --- //
+
+invitono::adoptersv2_table& invitono::adopters_at(uint64_t index) {
+  const contract_config& cfg = current_config();
+  return cfg.adopter_scopes == 0 ? adopters_in(get_self().value) : adopters_in(index);
+}//END adopters_at()
+
+// === Adopters In === //
+// --- One table object per scope per action --- //
+
+invitono::adoptersv2_table& invitono::adopters_in(uint64_t scope) {
+  auto itr = _scopes.find(scope);
+  if (itr == _scopes.end()) {
+    itr = _scopes.try_emplace(scope, get_self(), scope).first;
+  }
+  return itr->second;
+}//END adopters_in()
+
+// === Find Adopter === //
+// --- Packed table first, then archived rows, then legacy rows until migration completes --- //
+
+const invitono::adopterv2* invitono::find_adopter(name account) {
+  auto& adopters = adopters_for(account);
+  auto itr = adopters.find(account.value);
+  if (itr != adopters.end()) return &*itr;
+
+  auto converted = _converted.find(account.value);
+  if (converted != _converted.end()) return &converted->second;
+
+  // - Archived rows are unpacked here and moved back by update_adopter
+  auto cold = _cold.find(account.value);
+  if (cold != _cold.end()) {
+    return &_converted.emplace(account.value, unpack<adopterv2>(cold->data)).first->second;
+  }
+
+  // - One emptiness check per action once migration is done
+  if (!_legacy_drained) _legacy_drained = _legacy.begin() == _legacy.end();
+  if (*_legacy_drained) return nullptr;
+
+  auto legacy = _legacy.find(account.value);
+  if (legacy == _legacy.end()) return nullptr;
+  return convert_legacy(*legacy);
+}//END find_adopter()
+
+// === Convert Legacy === //
+// --- Legacy rows hold only invitedby, so paths are rebuilt from the nearest converted ancestor down --- //
+
+const invitono::adopterv2* invitono::convert_legacy(const adopter& legacy) {
+  // - Walk invitedby up to a row that already has a path (or a root), collecting legacy rows
+  std::vector<const adopter*> chain{&legacy};
+  while (true) {
+    name inviter = chain.back()->invitedby;
+    if (inviter == get_self() || inviter == name{} || inviter == chain.back()->account) break;
+    if (_converted.count(inviter.value) || _cold.find(inviter.value) != _cold.end()) break;
+
+    auto& adopters = adopters_for(inviter);
+    if (adopters.find(inviter.value) != adopters.end()) break;
+
+    auto ancestor = _legacy.find(inviter.value);
+    if (ancestor == _legacy.end()) break;
+
+    // - User actions rebuild a bounded stretch; deeper unmigrated chains wait for migrate, which walks them in chunks
+    check(chain.size() <= MAX_UPLINE, "🎵 This account's invite chain is still migrating, try again after the next migrate");
+    chain.push_back(&*ancestor);
+  }
+
+  // - Convert top-down so each row links to its inviter's rebuilt path
+  const adopterv2* row = nullptr;
+  for (auto itr = chain.rbegin(); itr != chain.rend(); ++itr) {
+    adopterv2 packed = pack_adopter(**itr);
+    name inviter = packed.invitedby;
+    link_upline(packed, inviter == get_self() ? nullptr : find_adopter(inviter));
+    row = &_converted.emplace(packed.account.value, std::move(packed)).first->second;
+  }
+  return row;
+}//END convert_legacy()
+
+// === Pack Adopter === //
+// --- Copies a legacy row's own fields; the path is linked by convert_legacy --- //
+
+invitono::adopterv2 invitono::pack_adopter(const adopter& legacy) {
+  adopterv2 row;
+  row.account = legacy.account;
+  row.invitedby = legacy.invitedby;
+  row.lastupdated = legacy.lastupdated;
+  row.score = legacy.score;
+  row.flags = legacy.claimed ? adopterv2::FLAG_CLAIMED : 0;
+
+  // - The legacy rate limit ran from lastupdated, so the bucket starts empty there
+  row.bucket_updated = legacy.lastupdated;
+
+  // - fundpool waits for migration, so no funding has arrived yet and the zero checkpoint is current
+  return row;
+}//END pack_adopter()
@@ -4,7 +4,13 @@
 #include <eosio/time.hpp>
 #include <eosio/singleton.hpp>
 #include <eosio/permission.hpp> 
+#include <eosio/crypto.hpp>
+#include <map>
+#include <optional>
 #include "tonomy/tonomy.hpp"
+#include "curves.hpp"
+#include "rewards.hpp"
+#include "decay.hpp"
 
 using namespace eosio;
 using std::string;
@@ -14,7 +20,11 @@ using std::string;
 
 CONTRACT invitono : public contract {
 public:
-  using contract::contract;
+  invitono(name receiver, name code, datastream<const char*> ds)
+    : contract(receiver, code, ds), _legacy(receiver, receiver.value), _cold(receiver, receiver.value) {}
+
+  // - Flushes state batched during the action
+  ~invitono();
 
   // === User Actions === //
   // --- Core user interactions --- //
@@ -22,6 +32,17 @@ public:
   // - Register new user with invite code
   ACTION redeeminvite(name user, name inviter);
 
+  /*/
+  One (user, inviter) pair of a batch registration
+  /*/
+  struct invite {
+    name user;     // - New user account
+    name inviter;  // - Referrer account
+  };
+
+  // - Register many users in one go with combined upline updates
+  ACTION redeembatch(std::vector<invite> invites);
+
   // - Claim rewards based on score
   ACTION claimreward(name user);
 
@@ -38,6 +59,121 @@ public:
       uint32_t reward_rate
   );
 
+  // - Admin scoring mode management
+  ACTION setscoring(bool lazy_scores);
+
+  // - Admin per-level weight decay (percent kept per level down)
+  ACTION setdecay(uint8_t level_decay);
+
+  // - Admin score half-life (seconds, 0 = no decay)
+  ACTION sethalflife(uint32_t half_life);
+
+  // - Admin switch between per-point rewards and pro-rata pool payouts
+  ACTION setpoolmode(bool pool_mode);
+
+  // - Admin adds a budget to the pool, shared pro rata by every stored score
+  ACTION fundpool(asset amount);
+
+  // - Admin resolves the Tonomy app permission once and caches it in config
+  ACTION settonomy(string app_username);
+
+  // - Admin invite token bucket size and refill interval
+  ACTION setlimiter(uint16_t burst, uint32_t refill_seconds);
+
+  // - Admin reward curve selection
+  ACTION setcurve(uint8_t curve, uint32_t step);
+
+  // - Admin leaderboard size and byscore index management
+  ACTION setboard(uint16_t size, bool index_scores);
+
+  // - Admin stats shard count management
+  ACTION setshards(uint16_t shards);
+
+  // - Admin adopter scope partitioning (only while no users exist)
+  ACTION setscopes(uint16_t scopes);
+
+  // - Send up to max_items queued payouts, grouped by recipient
+  ACTION processq(uint32_t max_items);
+
+  // - Admin moves a recipient's queued payouts aside so a failing transfer stops blocking the queue
+  ACTION parkpayee(name recipient);
+
+  // - Admin puts a parked payout back at the end of the queue
+  ACTION requeue(uint64_t id);
+
+  // - Admin drops a parked payout for good
+  ACTION cancelpayout(uint64_t id);
+
+  // - Credit a user's deferred invites to their upline
+  ACTION settle(name user);
+
+  // - Read-only k-th ancestor lookup
+  [[eosio::action, eosio::read_only]] name getancestor(name user, uint16_t k);
+
+  // - Read-only lowest common ancestor lookup
+  [[eosio::action, eosio::read_only]] name getlca(name a, name b);
+
+  /*/
+  One credited ancestor of a user
+  /*/
+  struct upline_entry {
+    name     account;  // - Ancestor account
+    uint16_t level;    // - 1 for the inviter, 2 for theirs, ...
+    uint32_t score;    // - Current referral score
+  };
+
+  // - Read-only ancestors credited by this user's invites, nearest first
+  [[eosio::action, eosio::read_only]] std::vector<upline_entry> getupline(name user);
+
+  /*/
+  What a claimreward would pay right now
+  /*/
+  struct claim_preview {
+    uint32_t score = 0;     // - Score after settling pending invites
+    uint32_t pending = 0;   // - Invites that the claim would settle first
+    uint32_t position = 0;  // - Curve position (bonus percent)
+    asset    reward;        // - Tokens the claim would transfer
+  };
+
+  // - Read-only reward estimate using the contract's own curve and rate math
+  [[eosio::action, eosio::read_only]] claim_preview previewclaim(name user);
+
+  /*/
+  One page of a user's direct invitees
+  /*/
+  struct downline_page {
+    std::vector<name> invitees;  // - Direct invitees in account order
+    name              next;      // - lower_bound for the next page (empty when done)
+  };
+
+  // - Read-only direct invitees from lower_bound on, at most limit per page
+  [[eosio::action, eosio::read_only]] downline_page getdownline(name user, name lower_bound, uint16_t limit);
+
+  // - Move up to max_rows legacy adopter rows into the packed table
+  ACTION migrate(uint32_t max_rows);
+
+  // - Compact up to max_rows claimed adopters idle for inactive_days down to their place in the tree, resuming from a cursor
+  ACTION prune(uint32_t max_rows, uint32_t inactive_days);
+
+  // - Contract or admin moves up to max_rows adopters idle for inactive_days into the cold table, resuming from a cursor
+  ACTION archive(uint32_t max_rows, uint32_t inactive_days);
+
+  // - Admin commits the Merkle root of (user, inviter, score) onboarding leaves
+  ACTION setroot(checksum256 root);
+
+  /*/
+  One onboarding leaf with its Merkle proof
+  /*/
+  struct onboard_leaf {
+    name     user;                      // - Imported account
+    name     inviter;                   // - Its referrer in the off-chain graph
+    uint32_t score;                     // - Initial referral score
+    std::vector<checksum256> proof;     // - Sibling hashes, leaf level first
+  };
+
+  // - Creates rows for a chain of proven leaves, nearest the root first, billed to payer
+  ACTION materialize(name payer, std::vector<onboard_leaf> chain);
+
   // - Development utility action
   ACTION deleteuser(name user);
 
@@ -45,7 +181,7 @@ public:
   // --- Tracks registered users and referral statistics --- //
 
   /*/
-  Tracks each registered user and their referral stats
+  Legacy adopter layout, drained into adoptersv2 by migrate
   /*/
   TABLE adopter {
     name        account;          // - WAX account name
@@ -62,6 +198,104 @@ public:
     indexed_by<"byscore"_n, const_mem_fun<adopter, uint64_t, &adopter::by_score>>
   >;
 
+  /*/
+  Tracks each registered user and their referral stats in a packed layout
+  /*/
+  TABLE adopterv2 {
+    name         account;          // - WAX account name
+    name         invitedby;        // - Referrer account
+    uint32_t     lastupdated = 0;  // - Last score update timestamp
+    unsigned_int score;            // - Current referral score (varint)
+    uint8_t      fraction = 0;     // - Score remainder in 1/256 points from weighted levels
+    unsigned_int pending;          // - Direct invites not yet credited to the upline (varint)
+    unsigned_int depth;            // - Number of ancestors, 0 when invited by the contract (varint)
+    uint8_t      flags = 0;        // - Status bits (FLAG_*)
+    std::vector<name> upline;      // - Ancestors, nearest first (up to MAX_UPLINE)
+    std::vector<name> jumps;       // - 2^k-th ancestors for k the upline can't supply
+    std::vector<unsigned_int> levels; // - levels[i] = descendants i + 1 levels down, up to the credited depth (varint)
+    unsigned_int subtree;          // - Sum of levels: descendants within the credited depth (varint)
+    uint128_t    checkpoint = 0;   // - Pool reward per score when owed was last brought up to date
+    uint64_t     owed = 0;         // - Pool rewards accrued and not yet claimed (token base units)
+    uint16_t     bucket_tokens = 0;   // - Invites left in the rate-limit bucket as of bucket_updated
+    uint32_t     bucket_updated = 0;  // - Refill clock of the bucket, separate from lastupdated
+
+    // - Status bits
+    static constexpr uint8_t FLAG_CLAIMED = 1 << 0;    // - Reward claimed at least once
+    static constexpr uint8_t FLAG_UNINDEXED = 1 << 1;  // - byscore key frozen while the index is off
+    static constexpr uint8_t FLAG_IMPORTED = 1 << 2;   // - Materialized from the onboarding Merkle root
+    static constexpr uint8_t FLAG_COMPACT = 1 << 3;    // - Pruned down to its place in the tree until written again
+
+    uint64_t primary_key() const { return account.value; }
+    uint64_t by_score() const { // - Sort descending, unindexed rows last with a key that never changes
+      return (flags & FLAG_UNINDEXED) ? UINT64_MAX : static_cast<uint64_t>(UINT32_MAX - score.value);
+    }
+    uint128_t by_inviter() const { return (static_cast<uint128_t>(invitedby.value) << 64) | account.value; } // - Invitees grouped by inviter
+
+    bool claimed() const { return flags & FLAG_CLAIMED; }
+    void set_indexed(bool indexed) { flags = indexed ? (flags & ~FLAG_UNINDEXED) : (flags | FLAG_UNINDEXED); }
+
+    // - Adds count invites at weight 1/256 points each, carrying the remainder
+    void add_points(uint32_t count, uint16_t weight) {
+      uint64_t total = fraction + static_cast<uint64_t>(weight) * count;
+      score.value += static_cast<uint32_t>(total >> 8);
+      fraction = static_cast<uint8_t>(total & 0xFF);
+    }
+
+    // - Adds pool rewards earned by the current score since the checkpoint
+    void accrue(uint128_t reward_per_score) {
+      owed += static_cast<uint64_t>((static_cast<uint128_t>(score.value) * (reward_per_score - checkpoint)) >> 64);
+      checkpoint = reward_per_score;
+    }
+
+    // - Refills the invite bucket one token per refill_seconds up to burst, then spends count (false if short)
+    bool take_invites(uint32_t count, uint16_t burst, uint32_t refill_seconds, uint32_t now) {
+      uint64_t refills = refill_seconds == 0 ? burst : (now - bucket_updated) / refill_seconds;
+      if (bucket_tokens + refills >= burst) {
+        bucket_tokens = burst;
+        bucket_updated = now;
+      } else {
+        bucket_tokens += refills;
+        bucket_updated += refills * refill_seconds;
+      }
+      if (bucket_tokens < count) return false;
+      bucket_tokens -= count;
+      return true;
+    }
+
+    // - Counts new descendants level levels down (1 = direct invitees)
+    void add_descendants(uint32_t level, uint32_t count) {
+      if (levels.size() < level) levels.resize(level);
+      levels[level - 1].value += count;
+      subtree.value += count;
+    }
+
+    // - Jumps with 2^k within the upline are read from it instead of stored
+    uint32_t path_jumps() const { return upline.empty() ? 0 : 32 - __builtin_clz(upline.size()); }
+    uint32_t jump_count() const { return path_jumps() + jumps.size(); }
+    name jump(uint32_t k) const { return k < path_jumps() ? upline[(1u << k) - 1] : jumps[k - path_jumps()]; }
+  };
+
+  using adoptersv2_table = multi_index<"adoptersv2"_n, adopterv2,
+    indexed_by<"byscore"_n, const_mem_fun<adopterv2, uint64_t, &adopterv2::by_score>>,
+    indexed_by<"byinviter"_n, const_mem_fun<adopterv2, uint128_t, &adopterv2::by_inviter>>
+  >;
+
+  /*/
+  Inactive adopter, serialized whole with only an inviter index until touched again
+  /*/
+  TABLE coldadopter {
+    name              account;    // - WAX account name
+    name              invitedby;  // - Referrer account, outside the blob so invitees can be listed and re-pointed
+    std::vector<char> data;       // - Packed adopterv2 row
+
+    uint64_t primary_key() const { return account.value; }
+    uint128_t by_inviter() const { return (static_cast<uint128_t>(invitedby.value) << 64) | account.value; }
+  };
+
+  using coldadopters_table = multi_index<"coldadopters"_n, coldadopter,
+    indexed_by<"byinviter"_n, const_mem_fun<coldadopter, uint128_t, &coldadopter::by_inviter>>
+  >;
+
   // === Config Singleton === //
   // --- Contract configuration values --- //
 
@@ -70,7 +304,7 @@ public:
   /*/
   TABLE config {
     uint32_t min_account_age_days = 30; // - Minimum registration age (days)
-    uint32_t invite_rate_seconds = 3600; // - Score update cooldown (seconds)
+    uint32_t invite_rate_seconds = 3600; // - Seconds to refill one invite token
     bool     enabled = true;             // - Contract operational status
     name     admin;                      // - Admin account
     uint16_t max_referral_depth = 5;     // - Maximum referral levels
@@ -82,6 +316,33 @@ public:
 
   using config_table = singleton<"config"_n, config>;
 
+  /*/
+  Settings added after the config singleton was deployed, kept apart so existing config rows still unpack
+  /*/
+  TABLE settings {
+    bool     lazy_scores = false;        // - Defer upline credits until settle/claim
+    uint8_t  reward_curve = curves::TETRAHEDRAL; // - Bonus position curve
+    uint32_t curve_step = 100;           // - Points per position (capped-linear curve)
+    uint16_t leaderboard_size = 0;       // - Top-K leaderboard entries (0 = off)
+    bool     index_scores = true;        // - Keep byscore index keys current
+    uint16_t stats_shards = 0;           // - Stats shard count (0 = single stats singleton)
+    uint16_t adopter_scopes = 0;         // - Adopter hash-bucket scopes (0 = contract scope only)
+    uint8_t  level_decay = 100;          // - Weight kept per level down (percent, 100 = flat)
+    std::vector<uint16_t> level_weights; // - Points per invite by level in 1/256 (built from level_decay, empty = flat)
+    uint32_t half_life = 0;              // - Score half-life (seconds, 0 = no decay)
+    bool     pool_mode = false;          // - Pay pool shares instead of reward_rate per point
+    name     tonomy_app;                 // - Cached Tonomy app permission (empty = Tonomy ID auth off)
+    uint16_t invite_burst = 1;           // - Invite bucket size: invites an inviter can send back to back
+    checksum256 onboard_root;            // - Merkle root of onboarding leaves (zero = none)
+  };
+
+  using settings_table = singleton<"settings"_n, settings>;
+
+  /*/
+  Config and settings as one read-only view for the action
+  /*/
+  struct contract_config : config, settings {};
+
   // === Stats Singleton === //
   // --- Global contract statistics --- //
 
@@ -96,34 +357,436 @@ public:
 
   using stats_table = singleton<"stats"_n, stats>;
 
+  /*/
+  One shard of the global statistics, picked by a hash of the user name
+  /*/
+  TABLE statshard {
+    uint64_t id;                      // - Shard number
+    uint64_t total_referrals = 0;     // - Referral connections counted in this shard
+    uint64_t total_users = 0;         // - Users counted in this shard
+    name     last_registered;         // - Most recent registration in this shard
+    uint32_t last_registered_at = 0;  // - Its timestamp, to find the latest across shards
+    int64_t  total_score = 0;         // - Net change of stored adopter scores counted in this shard
+
+    uint64_t primary_key() const { return id; }
+  };
+
+  using statshards_table = multi_index<"statshards"_n, statshard>;
+
+  // - Read-only global statistics summed across shards
+  [[eosio::action, eosio::read_only]] stats getstats();
+
+  // === Leaderboard Singleton === //
+  // --- Top inviters kept current as scores change --- //
+
+  /*/
+  One leaderboard entry
+  /*/
+  struct leader {
+    name     account;  // - Adopter account
+    uint32_t score;    // - Score at last update
+  };
+
+  /*/
+  Top leaderboard_size adopters by score
+  /*/
+  TABLE leaderboard {
+    std::vector<leader> leaders; // - Highest score first
+  };
+
+  using leaderboard_table = singleton<"leaderboard"_n, leaderboard>;
+
+  // === Payout Queue === //
+  // --- Claimed rewards waiting for the processq crank --- //
+
+  /*/
+  One claimed reward not yet transferred
+  /*/
+  TABLE payout {
+    uint64_t id;              // - Queue order
+    name     recipient;       // - Claiming user
+    name     token_contract;  // - Token contract at claim time
+    asset    quantity;        // - Reward amount
+    uint32_t queued_at = 0;   // - Claim timestamp
+
+    uint64_t primary_key() const { return id; }
+    uint64_t by_recipient() const { return recipient.value; }
+  };
+
+  using payouts_table = multi_index<"payouts"_n, payout,
+    indexed_by<"byrecipient"_n, const_mem_fun<payout, uint64_t, &payout::by_recipient>>
+  >;
+
+  // - Payouts set aside by parkpayee, keeping their queue id
+  using parked_table = multi_index<"parkedpays"_n, payout,
+    indexed_by<"byrecipient"_n, const_mem_fun<payout, uint64_t, &payout::by_recipient>>
+  >;
+
+  // === Prune Cursor Singleton === //
+  // --- Where the next prune call resumes --- //
+
+  /*/
+  Position of the prune walk across scopes
+  /*/
+  TABLE prunecursor {
+    uint64_t scope = 0;  // - Scope index in walk order
+    uint64_t next = 0;   // - Lowest account value not yet examined in that scope
+  };
+
+  using prunecursor_table = singleton<"prunecursor"_n, prunecursor>;
+
+  // - The archive walk keeps its own position in the same shape
+  using archivecursor_table = singleton<"archcursor"_n, prunecursor>;
+
+  // === Migrate Cursor Singleton === //
+  // --- Where the next migrate call resumes --- //
+
+  /*/
+  Legacy accounts walked up from the next row to migrate, waiting for their inviters to migrate first
+  /*/
+  TABLE migcursor {
+    std::vector<name> waiting;  // - Deepest first; the last entry's inviter is already packed or still being walked
+  };
+
+  using migcursor_table = singleton<"migcursor"_n, migcursor>;
+
+  // === Pool Singleton === //
+  // --- Cumulative reward per score for pro-rata payouts --- //
+
+  /*/
+  Global pool accumulator; each row settles against it from its checkpoint
+  /*/
+  TABLE pool {
+    uint128_t reward_per_score = 0;  // - Cumulative token base units per score point (Q64)
+    uint64_t  funded = 0;            // - Total budget added by fundpool (token base units)
+  };
+
+  using pool_table = singleton<"pool"_n, pool>;
+
 private:
+  // - The native bench harness (bench/fixture.hpp) times internal helpers directly
+  friend class invitono_bench;
+
   // === Internal Functions === //
   // --- Core business logic --- //
 
-  // - Updates scores for inviter and their upline
-  void update_scores(name direct_inviter);
+  // - Validates an invite and returns the inviter's row (nullptr for the contract)
+  const adopterv2* check_invite(name user, name inviter, const contract_config& cfg, uint32_t now);
 
-  // === Constants === //
-  // --- Tetrahedral series values --- //
+  // - Checks the inviter's bucket holds count invites
+  void check_invite_rate(const adopterv2& inviter_row, uint32_t count, const contract_config& cfg, uint32_t now);
+
+  // - Creates the adopter row for a new user and returns its upline path
+  std::vector<name> add_adopter(name user, name inviter, const adopterv2* inviter_row, uint32_t now, name payer, uint32_t score = 1, uint8_t flags = 0);
+
+  // - Fills a row's upline path, depth and jump pointers from its inviter's row
+  void link_upline(adopterv2& row, const adopterv2* inviter_row);
+
+  // - Hashes a leaf and its proof up to a Merkle root (sorted pairs)
+  static checksum256 merkle_root(const onboard_leaf& leaf);
+
+  // - Extends an upline path to depth ancestors through the stored paths of its ancestors
+  std::vector<name> collect_upline(const std::vector<name>& upline, uint16_t depth);
+
+  // - Finds the k-th ancestor in O(log k) jumps (empty name if none); fails when it must jump through a removed row
+  name kth_ancestor(name account, uint32_t k);
+
+  // - Finds the lowest common ancestor in O(log depth) jumps (empty name for separate trees); fails on a removed row
+  name lowest_common_ancestor(name a, name b);
+
+  // - Adds increment to the first depth ancestors of an upline path, whose first entry sits level levels above the new users;
+  // - the first entry also spends spend rate-limit tokens in the same write
+  void update_scores(const std::vector<name>& upline, uint16_t depth, uint32_t increment, uint32_t now, uint16_t level = 1, uint32_t spend = 0);
+
+  // - Credits a row's pending invites to itself and its upline
+  void settle_pending(const adopterv2& user_row, const contract_config& cfg, uint32_t now);
+
+  // - Tokens a claim of this score pays (zero amount when it rounds down)
+  asset reward_for(uint32_t score, uint32_t position, const contract_config& cfg);
+
+  // - Records a claimed reward for processq to transfer
+  void queue_payout(name recipient, asset quantity, const contract_config& cfg, uint32_t now);
+
+  // - Returns the config after checking admin authorization
+  config admin_config(config_table& conf);
+
+  // - Returns the settings after checking admin authorization
+  settings admin_settings(settings_table& sets);
+
+  // - Moves a row into, within or out of the leaderboard after a score change
+  void track_leader(const adopterv2& row, const contract_config& cfg);
+
+  // - Fills one free leaderboard place from the byscore indexes, ignoring skip
+  void refill_board(const contract_config& cfg, name skip);
+
+  // - Fills every free leaderboard place from the byscore indexes
+  void fill_board(const contract_config& cfg);
+
+  // - Counts registrations in each user's stats shard (or the stats singleton), one write per touched shard;
+  // - the action's score change rides along when its shard is among them
+  void add_stats(const std::vector<name>& users, uint32_t now);
+
+  // - Writes the action's score change to its stats shard, when add_stats didn't carry it
+  void flush_score();
+
+  // - Sums the stored score total across the stats shards
+  uint64_t score_total();
+
+  // - Counts a removed user in the REMOVED_SHARD row
+  void remove_stats();
+
+  // - Re-points a removed row's direct invitees and drops it from totals, stats and the leaderboard
+  void release_adopter(const adopterv2& row, const std::vector<name>& invitees);
+
+  // - First count direct invitees from lower_bound on, merged across scopes
+  std::vector<name> collect_invitees(name user, name lower_bound, uint32_t count);
+
+  // - Sums the stats singleton and every shard, less removals
+  stats aggregate_stats();
+
+  // === Action State === //
+  // --- Loaded at most once per action --- //
+
+  // - Config cache
+  std::optional<contract_config> _config;
+
+  // - Leaderboard cache, written back by the destructor when dirty
+  std::optional<leaderboard> _board;
+  bool _board_dirty = false;
+
+  // - Pool cache, written back by the destructor when dirty
+  std::optional<pool> _pool;
+  bool _pool_dirty = false;
 
-  // - Pre-calculated tetrahedral series values
-  const std::vector<uint32_t> TETRAHEDRAL = {1, 4, 10, 20, 35, 56, 84, 120, 165, 220, 286, 364, 455, 560, 680, 816, 969, 1140, 1330, 1540, 1771, 2024, 2300, 2600, 999999999};
+  // - Net change of stored scores this action, counted in the first changed account's stats shard
+  int64_t _score_delta = 0;
+  name _score_account;
 
-  // - Calculates position in tetrahedral series
-  uint32_t calculate_tetrahedral_position(uint32_t score) {
-    // - Find largest n where T(n) <= score
-    for (size_t i = 0; i < TETRAHEDRAL.size(); i++) {
-      if (TETRAHEDRAL[i] > score) {
-        return i; // - Return index where score exceeded
+  // - Config for this action
+  const contract_config& current_config();
+
+  // - Pool for this action
+  pool& current_pool();
+
+  // - Adds a change of account's stored score to the action's score total change
+  void track_score(name account, int64_t delta);
+
+  // - Stats shard holding the score change of an action that started with account
+  uint64_t score_shard(name account);
+
+  // - Pool rewards a row would hold after accruing, without changing it
+  uint64_t pool_owed(const adopterv2& row);
+
+  // - Leaderboard for this action
+  leaderboard& current_board();
+
+  // === Adopter Storage === //
+  // --- Packed rows with transparent fallback to legacy rows --- //
+
+  // - Packed rows per scope, shared by all helpers so repeated lookups hit the table cache
+  std::map<uint64_t, adoptersv2_table> _scopes;
+
+  // - Packed table holding an account's row
+  adoptersv2_table& adopters_for(name account);
+
+  // - Table for one scope
+  adoptersv2_table& adopters_in(uint64_t scope);
+
+  // - Number of scopes holding adopter rows
+  uint64_t scope_count();
+
+  // - Table for the index-th scope in walk order
+  adoptersv2_table& adopters_at(uint64_t index);
+
+  // - Legacy rows not yet migrated
+  adopters_table _legacy;
+
+  // - Whether the legacy table is empty (checked once per action)
+  std::optional<bool> _legacy_drained;
+
+  // - Archived rows, moved back on their next write
+  coldadopters_table _cold;
+
+  // - Legacy and cold rows unpacked on read, keyed by account
+  std::map<uint64_t, adopterv2> _converted;
+
+  // - Finds a user's row in the hot, cold or legacy table (nullptr if not registered)
+  const adopterv2* find_adopter(name account);
+
+  // - Converts a legacy row and up to MAX_UPLINE unconverted legacy ancestors into the packed layout, rebuilding their paths
+  const adopterv2* convert_legacy(const adopter& legacy);
+
+  // - Converts a legacy row's own fields into the packed layout
+  static adopterv2 pack_adopter(const adopter& legacy);
+
+  // - Visits up to budget rows across scopes from cursor, then archived rows when include_cold is set;
+  // - visit(row, erase, budget) may erase the row through erase() and spend more budget
+  template <typename Lambda>
+  void walk_adopters(prunecursor& cursor, uint32_t budget, bool include_cold, Lambda&& visit) {
+    // - The archived rows are one extra scope after the hot ones
+    uint64_t scopes = scope_count() + (include_cold ? 1 : 0);
+    if (cursor.scope >= scopes) cursor = prunecursor{};
+
+    while (budget > 0) {
+      if (cursor.scope == scope_count()) {
+        auto itr = _cold.lower_bound(cursor.next);
+        if (itr == _cold.end()) {
+          cursor = prunecursor{};
+          break;
+        }
+        budget--;
+        cursor.next = itr->account.value + 1;
+        visit(unpack<adopterv2>(itr->data), [&]() { _cold.erase(itr); }, budget);
+        continue;
+      }
+
+      auto& adopters = adopters_at(cursor.scope);
+      auto itr = adopters.lower_bound(cursor.next);
+
+      // - Next scope, stopping after a full pass
+      if (itr == adopters.end()) {
+        cursor.next = 0;
+        cursor.scope = (cursor.scope + 1) % scopes;
+        if (cursor.scope == 0) break;
+        continue;
       }
+      budget--;
+      cursor.next = itr->account.value + 1;
+      visit(*itr, [&]() { adopters.erase(itr); }, budget);
+    }
+  }//END walk_adopters()
+
+  // - Applies updater to a row, moving legacy and cold rows into the packed table first
+  template <typename Lambda>
+  void update_adopter(const adopterv2& row, Lambda&& updater) {
+    const contract_config& cfg = current_config();
+    uint32_t now = current_time_point().sec_since_epoch();
+    auto apply = [&](auto& packed) {
+      // - Accrue pool rewards at the old score before it changes, whatever the mode, so every stored score shares each funding
+      packed.accrue(current_pool().reward_per_score);
+
+      // - Bring the score to now before changing it; the clock moves by whole steps so no time decays twice or is lost
+      uint32_t clock = decay_row(packed, cfg, now);
+      updater(packed);
+      if (cfg.half_life > 0) packed.lastupdated = clock;
+      packed.set_indexed(cfg.index_scores);
+      packed.flags &= ~adopterv2::FLAG_COMPACT;
+    };
+
+    auto& adopters = adopters_for(row.account);
+    auto itr = adopters.find(row.account.value);
+    if (itr != adopters.end()) {
+      // - Varints and level counts grow the row; the chain won't bill that growth to a payer who didn't sign, so the contract takes the row over
+      adopterv2 updated = *itr;
+      apply(updated);
+      track_score(row.account, static_cast<int64_t>(updated.score.value) - itr->score.value);
+      name payer = pack_size(updated) > pack_size(*itr) ? get_self() : same_payer;
+      adopters.modify(itr, payer, [&](auto& packed) {
+        packed = updated;
+      });
+    } else {
+      // - Cold scores are already in the total; legacy scores join it here
+      auto cold = _cold.find(row.account.value);
+      int64_t before = cold != _cold.end() ? row.score.value : 0;
+      if (cold != _cold.end()) _cold.erase(cold);
+
+      // - Migrate on write so each user keeps a single row
+      itr = adopters.emplace(get_self(), [&](auto& packed) {
+        packed = row;
+        apply(packed);
+      });
+      track_score(row.account, static_cast<int64_t>(itr->score.value) - before);
+      auto legacy = _legacy.find(row.account.value);
+      if (legacy != _legacy.end()) _legacy.erase(legacy);
     }
-    return TETRAHEDRAL.size() - 1; // - Return last position for large scores
-  }//END calculate_tetrahedral_position()
 
+    track_leader(*itr, cfg);
+  }//END update_adopter()
+
+  // === Constants === //
+  // --- Upline path, depth and leaderboard limits --- //
+
+  // - Maximum ancestors stored on each adopter row
+  static constexpr uint16_t MAX_UPLINE = 10;
+
+  // - Maximum configurable referral depth
+  static constexpr uint16_t MAX_REFERRAL_DEPTH = 64;
+
+  // - Maximum leaderboard entries
+  static constexpr uint16_t MAX_LEADERBOARD = 100;
+
+  // - Maximum invitees per getdownline page
+  static constexpr uint16_t MAX_DOWNLINE_PAGE = 100;
+
+  // - One full point in level weight units
+  static constexpr uint16_t WEIGHT_ONE = 256;
+
+  // - Maximum payouts per processq call
+  static constexpr uint32_t MAX_PAYOUT_ITEMS = 100;
+
+  // - Maximum rows examined per prune call
+  static constexpr uint32_t MAX_PRUNE_ROWS = 100;
+
+  // - Maximum rows examined per archive call
+  static constexpr uint32_t MAX_ARCHIVE_ROWS = 100;
+
+  // - Maximum stats shards
+  static constexpr uint16_t MAX_STATS_SHARDS = 64;
+
+  // - statshards row counting removed users, apart from the hashed shards
+  static constexpr uint64_t REMOVED_SHARD = UINT64_MAX;
+
+  // - Maximum adopter scopes
+  static constexpr uint16_t MAX_ADOPTER_SCOPES = 64;
+
+  // - Spreads names over buckets (names end in zero bits, so mix first)
+  static uint64_t name_bucket(name account, uint16_t buckets) {
+    return ((account.value * 0x9E3779B97F4A7C15ull) >> 32) % buckets;
+  }//END name_bucket()
+
+  // - Points per invite at each level in 1/256, computed once when depth or decay changes
+  static std::vector<uint16_t> build_weights(uint16_t depth, uint8_t decay);
+
+  // - Weight of an invite level levels below an ancestor
+  static uint16_t level_weight(const contract_config& cfg, uint32_t level) {
+    return level <= cfg.level_weights.size() ? cfg.level_weights[level - 1] : WEIGHT_ONE;
+  }//END level_weight()
+
+  // - Decays score and fraction by the whole half_life / 64 steps since lastupdated; returns the clock advanced by those steps
+  static uint32_t decay_row(adopterv2& row, const contract_config& cfg, uint32_t now) {
+    if (cfg.half_life == 0) return now;
+
+    uint32_t step = cfg.half_life / decay::STEPS;
+    uint32_t steps = (now - row.lastupdated) / step;
+    uint64_t points = decay::decayed((static_cast<uint64_t>(row.score.value) << 8) | row.fraction, steps);
+    row.score = static_cast<uint32_t>(points >> 8);
+    row.fraction = static_cast<uint8_t>(points & 0xFF);
+
+    // - The part of a step not yet consumed stays on the clock; an empty score restarts it
+    return points == 0 ? now : row.lastupdated + steps * step;
+  }//END decay_row()
+
+  // - Score decayed from lastupdated to now under the configured half-life
+  static uint32_t current_score(const adopterv2& row, const contract_config& cfg, uint32_t now) {
+    adopterv2 decayed = row;
+    decay_row(decayed, cfg, now);
+    return decayed.score.value;
+  }//END current_score()
+
+  // - Calculates position on the configured reward curve
+  static uint32_t calculate_curve_position(uint32_t score, const contract_config& cfg) {
+    return curves::curve_position(cfg.reward_curve, cfg.curve_step, score);
+  }//END calculate_curve_position()
+
+
+  // - Tonomy system contract holding the apps table
+  static constexpr name TONOMY_CONTRACT = "tonomy"_n;
 
-  // Helper function to check Tonomy ID authorization
+  // Helper function to check Tonomy ID authorization against the cached app permission
   bool has_tonomy_auth(const name& user) {
-        require_auth({user, tonomysystem::tonomy::get_app_permission_by_username("invite.cxc.app.demo.tonomy.id")});
+        const contract_config& cfg = current_config();
+        if (cfg.tonomy_app == name{}) return false;
+        require_auth({user, cfg.tonomy_app});
         return true;
         }
 
@@ -0,0 +1,58 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// === Reward Math === //
+// --- Integer-only fixed-point reward calculation with saturation --- //
+
+namespace rewards {
+
+  // - Largest token precision supported by eosio::symbol
+  static constexpr uint8_t MAX_PRECISION = 18;
+
+  // - Largest asset amount (eosio::asset::max_amount)
+  static constexpr int64_t MAX_AMOUNT = (int64_t(1) << 62) - 1;
+
+  // - Fixed-point scales: reward_rate, bonus and multiplier are all 100 = 1.0x
+  static constexpr uint64_t DENOMINATOR = 100 * 100 * 100;
+
+  // - Builds 10^p for p = 0..MAX_PRECISION at compile time
+  constexpr std::array<uint64_t, MAX_PRECISION + 1> make_pow10() {
+    std::array<uint64_t, MAX_PRECISION + 1> values{};
+    uint64_t value = 1;
+    for (size_t i = 0; i <= MAX_PRECISION; i++) {
+      values[i] = value;
+      value *= 10;
+    }
+    return values;
+  }
+
+  static constexpr std::array<uint64_t, MAX_PRECISION + 1> POW10 = make_pow10();
+
+  // - Multiplies and clamps to limit instead of overflowing
+  constexpr unsigned __int128 mul_sat(unsigned __int128 a, uint64_t b, unsigned __int128 limit) {
+    if (a == 0 || b == 0) return 0;
+    if (a > limit / b) return limit;
+    return a * b;
+  }
+
+  // - score * 10^p * rate/100 * (100 + bonus)/100 * multiplier/100, floored once
+  constexpr int64_t reward_amount(uint32_t score, uint8_t precision, uint32_t reward_rate, uint32_t bonus_percent, uint16_t multiplier) {
+    // - Any numerator past this floors to more than MAX_AMOUNT
+    constexpr unsigned __int128 limit = static_cast<unsigned __int128>(MAX_AMOUNT + 1) * DENOMINATOR;
+
+    unsigned __int128 numerator = score;
+    numerator = mul_sat(numerator, reward_rate, limit);
+    numerator = mul_sat(numerator, uint64_t(100) + bonus_percent, limit);
+    numerator = mul_sat(numerator, multiplier, limit);
+    numerator = mul_sat(numerator, POW10[precision], limit);
+
+    unsigned __int128 amount = numerator / DENOMINATOR;
+    return amount > static_cast<unsigned __int128>(MAX_AMOUNT) ? MAX_AMOUNT : static_cast<int64_t>(amount);
+  }
+
+  static_assert(reward_amount(10, 4, 100, 3, 100) == 103000, "10 points at 1.00 token with a 3% bonus");
+  static_assert(reward_amount(UINT32_MAX, MAX_PRECISION, UINT32_MAX, 24, 1000) == MAX_AMOUNT, "Overflow must saturate");
+
+} // namespace rewards